@@ -0,0 +1,320 @@
+/* -------------------------------------------------------------------------------- *\
+|*                                                                                  *|
+|*    Copyright (C) 2019-2024 RedGogh All rights reserved.                          *|
+|*                                                                                  *|
+|*    Licensed under the Apache License, Version 2.0 (the "License");               *|
+|*    you may not use this file except in compliance with the License.              *|
+|*    You may obtain a copy of the License at                                       *|
+|*                                                                                  *|
+|*        http://www.apache.org/licenses/LICENSE-2.0                                *|
+|*                                                                                  *|
+|*    Unless required by applicable law or agreed to in writing, software           *|
+|*    distributed under the License is distributed on an "AS IS" BASIS,             *|
+|*    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.      *|
+|*    See the License for the specific language governing permissions and           *|
+|*    limitations under the License.                                                *|
+|*                                                                                  *|
+\* -------------------------------------------------------------------------------- */
+#ifndef VRT_AFFINE_H_
+#define VRT_AFFINE_H_
+
+#include "vrt.h"
+// std
+#include <stdexcept>
+
+///
+/// 紧凑的仿射变换矩阵。
+///
+/// 模型、骨骼、实例矩阵的最后一行恒为 (0, 0, 0, 1)，affine 只保存前三行：
+/// 按列存储 4 个 vec3（3 列线性部分 + 1 列平移），float 版本 48 字节（mat4 为 64 字节），
+/// 复合两个变换只需 36 次乘法（mat4 为 64 次），变换点只需 9 次。
+///
+///     affine3 world = parent * affine3(local);
+///     vec3 p = transform_point(world, v);
+///
+namespace vrt
+{
+        ///
+        /// @brief 3x4 仿射变换矩阵，等价于最后一行为 (0, 0, 0, 1) 的 mat<4, T>。
+        ///
+        /// @tparam T 浮点数类型
+        /// @tparam Q 列向量的存储限定符，packed 时 sizeof(affine<float>) == 48
+        ///
+        template<typename T, qualifier Q = packed>
+        struct affine {
+                // -- Data --
+
+                vec<3, T, Q> data[4]; /* data[0..2] 为线性部分的列，data[3] 为平移 */
+
+                // -- Constructor --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine() VRT_FUNC_DEFAULT_CTOR;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit affine(T const& s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine(
+                        vec<3, T, Q> const& c1,
+                        vec<3, T, Q> const& c2,
+                        vec<3, T, Q> const& c3,
+                        vec<3, T, Q> const& c4);
+
+                /* 丢弃 m 的最后一行，m 应为仿射矩阵 */
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit affine(mat<4, T, P> const& m);
+
+                // -- Conversion --
+
+                /* 补齐最后一行 (0, 0, 0, 1) */
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit operator mat<4, T, P>() const;
+
+                // -- Operator overrides --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> & operator[](size_t n);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> const& operator[](size_t n) const;
+
+        };
+
+        // -- typedef --
+
+        typedef struct affine<float> affinef32;
+        typedef struct affine<double> affinef64;
+        typedef struct affine<float> affine3;
+
+        // -- struct affine<T>: Global operator overrides --
+
+        ///
+        /// @brief 复合两个仿射变换：a * b（先应用 b，再应用 a）。
+        ///
+        /// 线性部分 27 次乘法，平移 9 次，共 36 次。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine<T, Q> operator*(affine<T, Q> const& a, affine<T, Q> const& b);
+
+        // -- Functions --
+
+        ///
+        /// @brief 使用仿射变换变换一个点：a[0] * x + a[1] * y + a[2] * z + a[3]。
+        ///
+        /// @see transform_direction()
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> transform_point(affine<T, Q> const& a, vec<3, T, P> const& p);
+
+        ///
+        /// @brief 使用仿射变换变换一个方向向量，忽略平移：a[0] * x + a[1] * y + a[2] * z。
+        ///
+        /// @see transform_point()
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> transform_direction(affine<T, Q> const& a, vec<3, T, P> const& d);
+
+        ///
+        /// @brief 计算仿射变换的逆变换。
+        ///
+        /// 线性部分用伴随矩阵求逆（三次叉积与一次除法），平移为 -L⁻¹ * t，
+        /// 不经过 mat4 的通用求逆。
+        ///
+        /// @param a 输入的仿射变换
+        /// @return affine<T> 返回 a 的逆变换
+        ///
+        /// @throws std::runtime_error 线性部分的行列式为 0（不可逆）时抛出
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine<T, Q> inverse(affine<T, Q> const& a);
+
+        ///
+        /// @brief 在仿射变换 `a` 基础上应用平移、旋转、缩放（右乘，即在 `a` 的局部坐标系中变换）。
+        ///
+        /// 与 mat4 版本的 translate()、rotate()、scale() 相同，只计算受影响的列。
+        ///
+        /// @param a 输入的仿射变换
+        /// @param v 平移向量、旋转轴或缩放向量
+        /// @param angle 旋转角度（度），整数角度使用 sincos_deg() 查表
+        /// @return affine<T> 返回变换后的仿射变换
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine<T, Q> translate(affine<T, Q> const& a, vec<3, T, P> const& v);
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine<T, Q> rotate(affine<T, Q> const& a, T angle, vec<3, T, P> const& v);
+
+        template<typename T, std::integral I, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine<T, Q> rotate(affine<T, Q> const& a, I angle, vec<3, T, P> const& v);
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine<T, Q> scale(affine<T, Q> const& a, vec<3, T, P> const& v);
+
+        // -- detail --
+
+        namespace detail
+        {
+                /* a = a * r，r 只有左上 3x3 非单位：平移列不变 */
+                template<typename T, qualifier Q, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void mul_linear(affine<T, Q>& a, mat<4, T, P> const& r);
+        }
+
+        // -- struct affine<T>: implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR affine<T, Q>::affine(T const& s)
+                : affine(vec<3, T, Q>(s, 0, 0),
+                         vec<3, T, Q>(0, s, 0),
+                         vec<3, T, Q>(0, 0, s),
+                         vec<3, T, Q>(0, 0, 0))
+        {}
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR affine<T, Q>::affine(
+                vec<3, T, Q> const& c1,
+                vec<3, T, Q> const& c2,
+                vec<3, T, Q> const& c3,
+                vec<3, T, Q> const& c4)
+        {
+                data[0] = c1;
+                data[1] = c2;
+                data[2] = c3;
+                data[3] = c4;
+        }
+
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR affine<T, Q>::affine(mat<4, T, P> const& m)
+                : affine(vec<3, T, Q>(m[0].x, m[0].y, m[0].z),
+                         vec<3, T, Q>(m[1].x, m[1].y, m[1].z),
+                         vec<3, T, Q>(m[2].x, m[2].y, m[2].z),
+                         vec<3, T, Q>(m[3].x, m[3].y, m[3].z))
+        {}
+
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR affine<T, Q>::operator mat<4, T, P>() const
+        {
+                return mat<4, T, P>(
+                        data[0].x, data[0].y, data[0].z, 0,
+                        data[1].x, data[1].y, data[1].z, 0,
+                        data[2].x, data[2].y, data[2].z, 0,
+                        data[3].x, data[3].y, data[3].z, 1);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q>& affine<T, Q>::operator[](size_t n)
+        {
+                VRT_CHECK_INDEX(n, 4);
+
+                return data[n];
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> const& affine<T, Q>::operator[](size_t n) const
+        {
+                VRT_CHECK_INDEX(n, 4);
+
+                return data[n];
+        }
+
+        // -- struct affine<T>: Global operator implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR affine<T, Q> operator*(affine<T, Q> const& a, affine<T, Q> const& b)
+        {
+                return affine<T, Q>(
+                        a[0] * b[0].x + a[1] * b[0].y + a[2] * b[0].z,
+                        a[0] * b[1].x + a[1] * b[1].y + a[2] * b[1].z,
+                        a[0] * b[2].x + a[1] * b[2].y + a[2] * b[2].z,
+                        a[0] * b[3].x + a[1] * b[3].y + a[2] * b[3].z + a[3]);
+        }
+
+        // -- Functions implements --
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> transform_point(affine<T, Q> const& a, vec<3, T, P> const& p)
+        {
+                return vec<3, T, P>(a[0].x * p.x + a[1].x * p.y + a[2].x * p.z + a[3].x,
+                                    a[0].y * p.x + a[1].y * p.y + a[2].y * p.z + a[3].y,
+                                    a[0].z * p.x + a[1].z * p.y + a[2].z * p.z + a[3].z);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> transform_direction(affine<T, Q> const& a, vec<3, T, P> const& d)
+        {
+                return vec<3, T, P>(a[0].x * d.x + a[1].x * d.y + a[2].x * d.z,
+                                    a[0].y * d.x + a[1].y * d.y + a[2].y * d.z,
+                                    a[0].z * d.x + a[1].z * d.y + a[2].z * d.z);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR affine<T, Q> inverse(affine<T, Q> const& a)
+        {
+                vec<3, T, Q> r[3];
+                detail::inverse_rows(a[0], a[1], a[2], r);
+
+                vec<3, T, Q> const& t = a[3];
+
+                return affine<T, Q>(
+                        vec<3, T, Q>(r[0].x, r[1].x, r[2].x),
+                        vec<3, T, Q>(r[0].y, r[1].y, r[2].y),
+                        vec<3, T, Q>(r[0].z, r[1].z, r[2].z),
+                        vec<3, T, Q>(-dot(r[0], t), -dot(r[1], t), -dot(r[2], t)));
+        }
+
+        namespace detail
+        {
+                template<typename T, qualifier Q, qualifier P>
+                VRT_FUNC_CONSTEXPR void mul_linear(affine<T, Q>& a, mat<4, T, P> const& r)
+                {
+                        vec<3, T, Q> c0 = a[0] * r[0].x + a[1] * r[0].y + a[2] * r[0].z;
+                        vec<3, T, Q> c1 = a[0] * r[1].x + a[1] * r[1].y + a[2] * r[1].z;
+                        vec<3, T, Q> c2 = a[0] * r[2].x + a[1] * r[2].y + a[2] * r[2].z;
+
+                        a[0] = c0;
+                        a[1] = c1;
+                        a[2] = c2;
+                }
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR affine<T, Q> translate(affine<T, Q> const& a, vec<3, T, P> const& v)
+        {
+                affine<T, Q> Result = a;
+                Result[3] = a[0] * v.x + a[1] * v.y + a[2] * v.z + a[3];
+
+                return Result;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR affine<T, Q> rotate(affine<T, Q> const& a, T angle, vec<3, T, P> const& v)
+        {
+                T s, c;
+                vrt::sincos(angle * T(M_PI / 180), s, c);
+
+                affine<T, Q> Result = a;
+                detail::mul_linear(Result, detail::axis_rotation<T, packed>(s, c, v));
+
+                return Result;
+        }
+
+        template<typename T, std::integral I, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR affine<T, Q> rotate(affine<T, Q> const& a, I angle, vec<3, T, P> const& v)
+        {
+                T s, c;
+                sincos_deg(int(angle % 360), s, c);
+
+                affine<T, Q> Result = a;
+                detail::mul_linear(Result, detail::axis_rotation<T, packed>(s, c, v));
+
+                return Result;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR affine<T, Q> scale(affine<T, Q> const& a, vec<3, T, P> const& v)
+        {
+                affine<T, Q> Result = a;
+
+                Result[0] *= v.x;
+                Result[1] *= v.y;
+                Result[2] *= v.z;
+
+                return Result;
+        }
+}
+
+#endif /* VRT_AFFINE_H_ */
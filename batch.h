@@ -0,0 +1,929 @@
+/* -------------------------------------------------------------------------------- *\
+|*                                                                                  *|
+|*    Copyright (C) 2019-2024 RedGogh All rights reserved.                          *|
+|*                                                                                  *|
+|*    Licensed under the Apache License, Version 2.0 (the "License");               *|
+|*    you may not use this file except in compliance with the License.              *|
+|*    You may obtain a copy of the License at                                       *|
+|*                                                                                  *|
+|*        http://www.apache.org/licenses/LICENSE-2.0                                *|
+|*                                                                                  *|
+|*    Unless required by applicable law or agreed to in writing, software           *|
+|*    distributed under the License is distributed on an "AS IS" BASIS,             *|
+|*    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.      *|
+|*    See the License for the specific language governing permissions and           *|
+|*    limitations under the License.                                                *|
+|*                                                                                  *|
+\* -------------------------------------------------------------------------------- */
+#ifndef VRT_BATCH_H_
+#define VRT_BATCH_H_
+
+#include "vrt.h"
+#include "quat.h"
+#include "dualquat.h"
+// std
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+///
+/// 批量内核与运行时 CPU 分派。
+///
+/// vec.h / vrt.h 中的函数按编译时的 -march 生成代码，分发到不同机器的二进制通常只有 SSE2。
+/// 本文件中的批量内核在 x86 GCC / Clang 下为每个指令集分别编译一份（target 属性），
+/// 首次调用时通过 cpuid 检测 CPU 并选定实现，之后直接通过函数指针调用。
+///
+/// 数据包（packet）的宽度在编译期确定，无法在运行时切换，需要宽数据包时应通过批量接口处理：
+/// 批量接口内部使用 detail::wide，宽度随跳板的指令集变化（AVX-512 下 float 为 16 个通道）。
+///
+/* 批量内核不依赖工程的优化等级：GCC 在 -O2 下只做低成本的向量化，这里对内核单独开启 O3；
+   内核不检查 errno，关闭后 sqrt 等才能向量化 */
+#if defined(__GNUC__) && !defined(__clang__)
+#  define VRT_VECTORIZE    __attribute__((optimize("O3", "no-math-errno")))
+#else
+#  define VRT_VECTORIZE    /* UNDEF */
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define VRT_DISPATCH 1
+#  define VRT_TARGET(isa)  __attribute__((target(isa))) VRT_VECTORIZE
+#else
+#  define VRT_DISPATCH 0
+#  define VRT_TARGET(isa)  VRT_VECTORIZE
+#endif
+
+/* 多线程批量接口中每个线程至少处理的元素个数，太小时线程创建的开销超过收益 */
+#ifndef VRT_BATCH_GRAIN
+#  define VRT_BATCH_GRAIN  16384
+#endif
+
+/* 内核 lambda 及其调用的 vec / quat / 数学函数必须内联进跳板函数，才会按跳板的指令集编译 */
+/* 跳板函数同时禁止跨过程优化（noipa）：GCC 的 IPA-SRA 等变换不区分目标指令集，
+   展开后会错误地改写跳板的参数，clang 没有该属性 */
+#if defined(__GNUC__) && !defined(__clang__)
+#  define VRT_KERNEL       __attribute__((always_inline))
+#  define VRT_FLATTEN      __attribute__((flatten, noipa))
+#elif defined(__clang__)
+#  define VRT_KERNEL       __attribute__((always_inline))
+#  define VRT_FLATTEN      __attribute__((flatten))
+#else
+#  define VRT_KERNEL       /* UNDEF */
+#  define VRT_FLATTEN      /* UNDEF */
+#endif
+
+namespace vrt
+{
+        // -- Instruction set --
+
+        ///
+        /// @brief 批量内核可选的指令集路径，按能力从低到高排列。
+        ///
+        enum isa {
+                isa_default,    /* 编译目标的基线指令集（x86-64 上为 SSE2） */
+                isa_sse42,
+                isa_avx2,       /* AVX2 + FMA */
+                isa_avx512      /* AVX-512 F/VL/DQ/BW */
+        };
+
+        ///
+        /// @brief 检测当前 CPU 支持的最高指令集路径。
+        ///
+        /// @return isa 非 x86 平台或不支持的编译器返回 isa_default
+        ///
+        VRT_FUNC_DECL VRT_INLINE isa detect_isa();
+
+        ///
+        /// @brief 批量内核实际使用的指令集路径，首次调用时检测一次并缓存。
+        ///
+        /// 可在程序启动时输出日志：printf("vrt: %s\n", isa_name(dispatch_isa()));
+        ///
+        /// @return isa 选定的路径
+        ///
+        VRT_FUNC_DECL VRT_INLINE isa dispatch_isa();
+
+        ///
+        /// @brief 返回指令集路径的名称（"default"、"sse4.2"、"avx2"、"avx512"）。
+        ///
+        VRT_FUNC_DECL VRT_INLINE const char* isa_name(isa i);
+
+        ///
+        /// @brief 批量变换三维点：dst[i] = (m * vec4(src[i], 1)).xyz。
+        ///
+        /// 按运行时检测到的指令集分派，src 与 dst 可以是同一数组，但不能部分重叠。
+        ///
+        /// @param m 4x4 变换矩阵
+        /// @param src 输入点
+        /// @param dst 输出点
+        /// @param n 点的个数
+        ///
+        /// @see transform_point()
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL void transform_points(mat<4, T, Q> const& m, vec<3, T, P> const* src, vec<3, T, P>* dst, size_t n);
+
+        ///
+        /// @brief 批量变换三维方向：dst[i] = (m * vec4(src[i], 0)).xyz，忽略平移。
+        ///
+        /// @see transform_points(), transform_direction()
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL void transform_directions(mat<4, T, Q> const& m, vec<3, T, P> const* src, vec<3, T, P>* dst, size_t n);
+
+        ///
+        /// @brief 批量变换四维向量：dst[i] = m * src[i]。
+        ///
+        /// @see transform_points()
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL void transform(mat<4, T, Q> const& m, vec<4, T, P> const* src, vec<4, T, P>* dst, size_t n);
+
+        ///
+        /// @brief 批量创建绕 x / y / z 轴旋转整数角度的旋转矩阵：dst[i] = rotate_*_deg(angdeg[i])。
+        ///
+        /// sin / cos 从 sincos_deg() 的表中读取，不调用超越函数，按运行时检测到的指令集分派。
+        ///
+        /// @param angdeg 旋转角度（整数度）
+        /// @param dst 输出矩阵
+        /// @param n 矩阵的个数
+        ///
+        /// @see rotate_x_deg(), rotate_y_deg(), rotate_z_deg(), sincos_deg()
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void rotate_x_deg(int const* angdeg, mat<4, T, Q>* dst, size_t n);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void rotate_y_deg(int const* angdeg, mat<4, T, Q>* dst, size_t n);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void rotate_z_deg(int const* angdeg, mat<4, T, Q>* dst, size_t n);
+
+        ///
+        /// @brief 批量插值两组四元数：dst[i] = nlerp(a[i], b[i], t) / slerp(a[i], b[i], t)。
+        ///
+        /// 用于动画姿势混合：每次读取 W 个四元数转置为 quat<detail::wide<T, W>>（SoA），
+        /// 以数据包计算后再写回，slerp 的 acos / sin 也按数据包计算。W 随运行时检测到的指令集变化
+        /// （float 在 AVX-512 / AVX2 / SSE 下为 16 / 8 / 4）。
+        /// dst 可以与 a 或 b 是同一数组，但不能部分重叠。
+        ///
+        /// @param a 起始四元数
+        /// @param b 结束四元数
+        /// @param t 插值系数，[0, 1]
+        /// @param dst 输出四元数
+        /// @param n 四元数的个数
+        ///
+        /// @see nlerp(), slerp()
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void nlerp(quat<T, Q> const* a, quat<T, Q> const* b, T t, quat<T, Q>* dst, size_t n);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void slerp(quat<T, Q> const* a, quat<T, Q> const* b, T t, quat<T, Q>* dst, size_t n);
+
+        ///
+        /// @brief 对偶四元数蒙皮（DLB）：每个顶点最多混合 4 个骨骼。
+        ///
+        /// 对第 i 个顶点，按 weights[i] 加权累加 bones[joints[i][k]]（与第一个骨骼的 real 夹角为钝角时取反，
+        /// 保证沿最短路径混合），除以 real 的长度后变换位置与法线：
+        ///
+        ///   dst[i] = transform_point(b, src[i])，dst_normals[i] = transform_direction(b, normals[i])
+        ///
+        /// 不使用的影响槽位权重填 0（骨骼索引仍需有效）。按运行时检测到的指令集分派，
+        /// src 与 dst、normals 与 dst_normals 可以是同一数组，但不能部分重叠。
+        ///
+        /// @param bones 骨骼的单位对偶四元数（蒙皮矩阵，即 骨骼世界变换 * 绑定姿势的逆）
+        /// @param joints 每个顶点的 4 个骨骼索引
+        /// @param weights 每个顶点的 4 个权重，和为 1
+        /// @param src 输入顶点位置
+        /// @param dst 输出顶点位置
+        /// @param normals 输入法线，可以为 nullptr
+        /// @param dst_normals 输出法线，normals 为 nullptr 时忽略
+        /// @param n 顶点个数
+        ///
+        /// @see dualquat, transform_point()
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL void skin_dualquat(dualquat<T, Q> const* bones, vec<4, int> const* joints, vec<4, T> const* weights,
+                                         vec<3, T, P> const* src, vec<3, T, P>* dst,
+                                         vec<3, T, P> const* normals, vec<3, T, P>* dst_normals, size_t n);
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL void skin_dualquat(dualquat<T, Q> const* bones, vec<4, int> const* joints, vec<4, T> const* weights,
+                                         vec<3, T, P> const* src, vec<3, T, P>* dst, size_t n);
+
+        ///
+        /// @brief 批量求 4x4 矩阵的逆矩阵：dst[i] = inverse(src[i])。
+        ///
+        /// 每次读取 W 个矩阵转置为 mat<4, detail::wide<T, W>>（SoA），一个数据包通道对应一个矩阵，
+        /// 余子式与行列式对 W 个矩阵同时计算。W 按运行时检测到的指令集选择（AVX-512 下 float 为 16），
+        /// src 与 dst 可以是同一数组，但不能部分重叠。
+        ///
+        /// @param src 输入矩阵
+        /// @param dst 输出逆矩阵
+        /// @param n 矩阵的个数
+        ///
+        /// @note 为了不打断数据包计算，不检查可逆性：不可逆矩阵的结果为 inf / nan，不抛出异常。
+        ///
+        /// @see inverse()
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void inverse(mat<4, T, Q> const* src, mat<4, T, Q>* dst, size_t n);
+
+        ///
+        /// @brief 批量 4x4 矩阵乘法：左侧固定 dst[i] = a * b[i]、右侧固定 dst[i] = a[i] * b，或逐对 dst[i] = a[i] * b[i]。
+        ///
+        /// 用于每个实例的 proj * view * model[i]：先算出 pv = proj * view，再调用 multiply(pv, model, dst, n)。
+        ///
+        /// float 矩阵在 x86 上按运行时检测到的指令集选择寄存器宽度 W（AVX-512 为 16，整个矩阵一个寄存器）：
+        /// 左矩阵的列在寄存器内按 128 位复制，右矩阵的元素在每 4 个通道内广播，每个矩阵只需 16 / W * 4 次乘加。
+        /// 矩阵保持原有的列主序布局，不做 SoA 转置，AVX2 / AVX-512 下吞吐与 memcpy 相当。
+        /// 其他类型按运行时检测到的指令集分派逐个调用 operator*。
+        ///
+        /// dst 可以与 a 或 b 是同一数组，但不能部分重叠。
+        ///
+        /// @param a 左矩阵（或左矩阵数组）
+        /// @param b 右矩阵数组（或右矩阵）
+        /// @param dst 输出矩阵
+        /// @param n 矩阵的个数
+        /// @param threads 线程数，0 表示 std::thread::hardware_concurrency()；
+        ///                每个线程至少处理 VRT_BATCH_GRAIN 个矩阵，数量较少时仍在调用线程中执行
+        ///
+        /// @note 计算受内存带宽限制，线程数超过内存通道所能喂饱的数量后不再加速。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void multiply(mat<4, T, Q> const& a, mat<4, T, Q> const* b, mat<4, T, Q>* dst, size_t n, unsigned threads = 1);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void multiply(mat<4, T, Q> const* a, mat<4, T, Q> const& b, mat<4, T, Q>* dst, size_t n, unsigned threads = 1);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL void multiply(mat<4, T, Q> const* a, mat<4, T, Q> const* b, mat<4, T, Q>* dst, size_t n, unsigned threads = 1);
+
+        // -- detail --
+
+        namespace detail
+        {
+                /* 每个指令集一份跳板函数，内核以 always_inline 的 lambda 传入，在跳板的 target 下展开编译 */
+                template<typename F>
+                VRT_TARGET("avx512f,avx512vl,avx512dq,avx512bw,avx2,fma") VRT_FLATTEN void run_avx512(F const& f) { f(); }
+
+                template<typename F>
+                VRT_TARGET("avx2,fma") VRT_FLATTEN void run_avx2(F const& f) { f(); }
+
+                template<typename F>
+                VRT_TARGET("sse4.2") VRT_FLATTEN void run_sse42(F const& f) { f(); }
+
+                template<typename F>
+                VRT_VECTORIZE VRT_FLATTEN void run_default(F const& f) { f(); }
+
+                /* 每种内核（F）首次调用时选定一次实现 */
+                template<typename F>
+                VRT_FUNC_DECL VRT_INLINE void dispatch(F const& f);
+
+                /*
+                 * 跳板内使用的 SoA 数据包，接口与 packet 相同（逐通道运算、比较得到掩码、where 混合）。
+                 *
+                 * packet 的 ABI 按编译目标确定，可移植的构建中只有 SSE2 的 4 个 float，跳板的 target 属性
+                 * 无法改变；wide 使用 GCC 向量扩展，内联进跳板后按跳板的指令集生成代码，W 由 dispatch_wide() 选择。
+                 * 存储只按元素对齐，按值传递时不涉及向量寄存器的 ABI。
+                 */
+                template<typename T, size_t W>
+                struct wide;
+
+                template<typename T, size_t W>
+                struct is_packet<wide<T, W>> : std::true_type {};
+
+                /* 以一个寄存器的通道数 W（std::integral_constant）调用 f(W)，在对应指令集的跳板内执行 */
+                template<typename T, typename F>
+                VRT_FUNC_DECL VRT_INLINE void dispatch_wide(F const& f);
+
+                /*
+                 * 连续 W 个四元数的 4 个寄存器原地转置为 x, y, z, w 分量（Store 为 true 时转置回去）。通道顺序无关紧要，
+                 * 只需写回时还原：W 为 4 的倍数时在每 4 个通道（一个四元数）内转置，自身即为逆变换；W 为 2 时读写各自交错。
+                 * 逐通道插入 / 提取在 AVX-512 下比整个内核还慢。
+                 */
+                template<size_t W, bool Store, typename R>
+                VRT_FUNC_DECL VRT_INLINE VRT_KERNEL void transpose_quats(R (&m)[4]);
+
+                /* 以 W 个一组转置为 SoA 数据包 wide<T, W> 调用 f(qa, qb)，不足一组的尾部逐个以标量调用 */
+                template<size_t W, typename T, qualifier Q, typename F>
+                VRT_FUNC_DECL VRT_INLINE void blend_quats(quat<T, Q> const* a, quat<T, Q> const* b, quat<T, Q>* dst, size_t n, F const& f);
+
+                /* 把 [0, n) 切分给 threads 个线程调用 f(begin, end)，每段至少 VRT_BATCH_GRAIN 个 */
+                template<typename F>
+                VRT_FUNC_DECL VRT_INLINE void parallel_for(size_t n, unsigned threads, F const& f);
+
+                /* dst[i] = A(i) * B(i)，VA / VB 表示 a / b 是否为数组（否则为单个固定矩阵） */
+                template<bool VA, bool VB, typename T, qualifier Q>
+                VRT_FUNC_DECL void multiply(mat<4, T, Q> const* a, mat<4, T, Q> const* b, mat<4, T, Q>* dst, size_t n, unsigned threads);
+        }
+
+        // -- implements --
+
+        VRT_FUNC_DECL VRT_INLINE isa detect_isa()
+        {
+#if VRT_DISPATCH
+                __builtin_cpu_init();
+
+                if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl")
+                    && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw"))
+                        return isa_avx512;
+
+                if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                        return isa_avx2;
+
+                if (__builtin_cpu_supports("sse4.2"))
+                        return isa_sse42;
+#endif
+                return isa_default;
+        }
+
+        VRT_FUNC_DECL VRT_INLINE isa dispatch_isa()
+        {
+                static const isa Result = detect_isa();
+                return Result;
+        }
+
+        VRT_FUNC_DECL VRT_INLINE const char* isa_name(isa i)
+        {
+                switch (i) {
+                        case isa_sse42:  return "sse4.2";
+                        case isa_avx2:   return "avx2";
+                        case isa_avx512: return "avx512";
+                        default:         return "default";
+                }
+        }
+
+        namespace detail
+        {
+                template<typename F>
+                VRT_FUNC_DECL VRT_INLINE void dispatch(F const& f)
+                {
+                        typedef void (*run_t)(F const&);
+
+                        static const run_t run = [] () -> run_t {
+                                switch (dispatch_isa()) {
+                                        case isa_avx512: return &run_avx512<F>;
+                                        case isa_avx2:   return &run_avx2<F>;
+                                        case isa_sse42:  return &run_sse42<F>;
+                                        default:         return &run_default<F>;
+                                }
+                        }();
+
+                        run(f);
+                }
+
+                template<typename T, size_t W>
+                struct wide {
+                        typedef T value_type;
+                        typedef T reg __attribute__((vector_size(W * sizeof(T)), aligned(sizeof(T)), may_alias));
+                        typedef decltype(reg() < reg()) mask_reg __attribute__((aligned(sizeof(T))));
+
+                        struct mask {
+                                mask_reg v;
+
+                                /*
+                                 * 以加法组合两个比较结果（-1 / 0）：按位与 / 或会被 GCC 折叠为布尔向量运算，
+                                 * 在默认指令集下按整数向量定型，内联进 AVX-512 跳板后无法映射到掩码寄存器而被拆成逐通道比较
+                                 */
+                                friend VRT_KERNEL mask operator&(mask a, mask b) { return { a.v + b.v == -2 }; }
+                                friend VRT_KERNEL mask operator|(mask a, mask b) { return { a.v + b.v != 0 }; }
+                                friend VRT_KERNEL mask operator!(mask a) { return { ~a.v }; }
+
+                                /* 任一通道为真：逐通道或起来，GCC 归约为对半折叠的 por */
+                                friend VRT_KERNEL bool any_of(mask a)
+                                {
+                                        auto Result = a.v[0];
+
+                                        for (size_t i = 1; i < W; i++)
+                                                Result |= a.v[i];
+
+                                        return Result != 0;
+                                }
+                        };
+
+                        /* where(m, x) = y：m 为真的通道写入 y */
+                        struct where_expr {
+                                mask m;
+                                wide& x;
+
+                                VRT_KERNEL void operator=(wide y) { x.v = m.v ? y.v : x.v; }
+                        };
+
+                        reg v;
+
+                        wide() = default;
+                        wide(T s) : v(reg{} + s) {}
+
+                        /* 第 i 个通道为 f(std::integral_constant<size_t, i>())，与 simd 的生成构造函数相同 */
+                        template<typename F>
+                        requires std::is_invocable_v<F const&, std::integral_constant<size_t, 0>>
+                        explicit wide(F const& f)
+                        {
+                                [&] <size_t... I> (std::index_sequence<I...>) {
+                                        ((v[I] = T(f(std::integral_constant<size_t, I>()))), ...);
+                                }(std::make_index_sequence<W>());
+                        }
+
+                        static constexpr size_t size() { return W; }
+
+                        static wide of(reg const& r) { wide Result; Result.v = r; return Result; }
+
+                        T operator[](size_t i) const { return v[i]; }
+
+                        wide& operator+=(wide b) { v += b.v; return *this; }
+                        wide& operator-=(wide b) { v -= b.v; return *this; }
+                        wide& operator*=(wide b) { v *= b.v; return *this; }
+                        wide& operator/=(wide b) { v /= b.v; return *this; }
+
+                        friend wide operator-(wide a) { return of(-a.v); }
+
+                        friend wide operator+(wide a, wide b) { return of(a.v + b.v); }
+                        friend wide operator-(wide a, wide b) { return of(a.v - b.v); }
+                        friend wide operator*(wide a, wide b) { return of(a.v * b.v); }
+                        friend wide operator/(wide a, wide b) { return of(a.v / b.v); }
+
+                        /* 比较及其掩码必须强制内联：先在默认指令集下编译的比较无法生成 AVX-512 的掩码寄存器，会被拆成逐通道比较 */
+                        friend VRT_KERNEL mask operator==(wide a, wide b) { return { a.v == b.v }; }
+                        friend VRT_KERNEL mask operator!=(wide a, wide b) { return { a.v != b.v }; }
+                        friend VRT_KERNEL mask operator<(wide a, wide b) { return { a.v < b.v }; }
+                        friend VRT_KERNEL mask operator<=(wide a, wide b) { return { a.v <= b.v }; }
+                        friend VRT_KERNEL mask operator>(wide a, wide b) { return { a.v > b.v }; }
+                        friend VRT_KERNEL mask operator>=(wide a, wide b) { return { a.v >= b.v }; }
+
+                        friend where_expr where(mask m, wide& x) { return { m, x }; }
+
+                        friend VRT_KERNEL wide abs(wide a) { return of(a.v < 0 ? -a.v : a.v); }
+
+                        /* 借用 std::experimental 的定长 simd：按编译选项的寄存器宽度分段执行 sqrtps，不走逐通道的 errno 检查 */
+                        friend wide sqrt(wide a)
+                        {
+                                std::experimental::fixed_size_simd<T, W> x(reinterpret_cast<T const*>(&a.v), std::experimental::element_aligned);
+
+                                std::experimental::sqrt(x).copy_to(reinterpret_cast<T*>(&a.v), std::experimental::element_aligned);
+
+                                return a;
+                        }
+
+                        /* 舍入到最近整数（|a| < 2^(digits - 2)）：加减 1.5 * 2^(digits - 1)，空 asm 阻止 -fassociative-math 把它化简为 a。
+                           不借用定长 simd：其 roundps 分支按编译选项而非跳板的指令集选择，默认构建下退化为更长的通用实现。
+                           寄存器约束与架构相关（x86 为 v，ARM 为 w），其他目标以内存操作数作屏障，多一次写回与读取 */
+                        friend VRT_KERNEL wide rint(wide a)
+                        {
+                                constexpr T magic = T(1.5) * T(1ull << (std::numeric_limits<T>::digits - 1));
+
+                                reg t = a.v + magic;
+#if defined(__x86_64__) || defined(__i386__)
+                                asm("" : "+v"(t));
+#elif defined(__aarch64__) || defined(__arm__)
+                                asm("" : "+w"(t));
+#else
+                                asm("" : "+m"(t));
+#endif
+
+                                return of(t - magic);
+                        }
+                };
+
+                template<typename T, typename F>
+                VRT_FUNC_DECL VRT_INLINE void dispatch_wide(F const& f)
+                {
+                        typedef std::integral_constant<size_t, 16 / sizeof(T)> w128;
+#ifdef __OPTIMIZE__
+                        typedef std::integral_constant<size_t, 64 / sizeof(T)> w512;
+                        typedef std::integral_constant<size_t, 32 / sizeof(T)> w256;
+#else
+                        /* 未优化时不内联，wide 的运算以函数调用传值：超过 128 位的向量在跳板（AVX 寄存器）
+                           与默认指令集编译的函数（栈）之间 ABI 不一致，只使用 128 位 */
+                        typedef w128 w512;
+                        typedef w128 w256;
+#endif
+
+                        switch (dispatch_isa()) {
+                                case isa_avx512: run_avx512([&] () VRT_KERNEL { f(w512()); }); break;
+                                case isa_avx2:   run_avx2([&] () VRT_KERNEL { f(w256()); }); break;
+                                case isa_sse42:  run_sse42([&] () VRT_KERNEL { f(w128()); }); break;
+                                default:         run_default([&] () VRT_KERNEL { f(w128()); }); break;
+                        }
+                }
+
+                template<size_t W, bool Store, typename R>
+                VRT_FUNC_DECL VRT_INLINE VRT_KERNEL void transpose_quats(R (&m)[4])
+                {
+                        if constexpr (W % 4 == 0) {
+                                [&] <size_t... I> (std::index_sequence<I...>) VRT_KERNEL {
+                                        /* 组内 unpacklo / unpackhi，再 movelh / movehl */
+                                        R t0 = __builtin_shufflevector(m[0], m[1], (I % 2 * W + I / 4 * 4 + I % 4 / 2)...);
+                                        R t1 = __builtin_shufflevector(m[0], m[1], (I % 2 * W + I / 4 * 4 + I % 4 / 2 + 2)...);
+                                        R t2 = __builtin_shufflevector(m[2], m[3], (I % 2 * W + I / 4 * 4 + I % 4 / 2)...);
+                                        R t3 = __builtin_shufflevector(m[2], m[3], (I % 2 * W + I / 4 * 4 + I % 4 / 2 + 2)...);
+
+                                        m[0] = __builtin_shufflevector(t0, t2, (I % 4 / 2 * W + I / 4 * 4 + I % 2)...);
+                                        m[1] = __builtin_shufflevector(t0, t2, (I % 4 / 2 * W + I / 4 * 4 + I % 2 + 2)...);
+                                        m[2] = __builtin_shufflevector(t1, t3, (I % 4 / 2 * W + I / 4 * 4 + I % 2)...);
+                                        m[3] = __builtin_shufflevector(t1, t3, (I % 4 / 2 * W + I / 4 * 4 + I % 2 + 2)...);
+                                }(std::make_index_sequence<W>());
+                        } else if constexpr (Store) {
+                                R r[4] = { m[0], m[1], m[2], m[3] };
+
+                                m[0] = __builtin_shufflevector(r[0], r[1], 0, 2);
+                                m[1] = __builtin_shufflevector(r[2], r[3], 0, 2);
+                                m[2] = __builtin_shufflevector(r[0], r[1], 1, 3);
+                                m[3] = __builtin_shufflevector(r[2], r[3], 1, 3);
+                        } else {
+                                R r[4] = { m[0], m[1], m[2], m[3] };
+
+                                m[0] = __builtin_shufflevector(r[0], r[2], 0, 2);
+                                m[1] = __builtin_shufflevector(r[0], r[2], 1, 3);
+                                m[2] = __builtin_shufflevector(r[1], r[3], 0, 2);
+                                m[3] = __builtin_shufflevector(r[1], r[3], 1, 3);
+                        }
+                }
+
+                template<size_t W, typename T, qualifier Q, typename F>
+                VRT_FUNC_DECL VRT_INLINE void blend_quats(quat<T, Q> const* a, quat<T, Q> const* b, quat<T, Q>* dst, size_t n, F const& f)
+                {
+                        typedef wide<T, W> P;
+                        typedef typename P::reg reg;
+
+                        static_assert(sizeof(quat<T, Q>) == 4 * sizeof(T));
+
+                        auto load = [] (quat<T, Q> const* p) VRT_KERNEL {
+                                /* reg 为 may_alias 且按元素对齐，直接读写；经 memcpy 时 GCC 会先按 16 字节搬到栈上，宽寄存器读回时无法存储转发 */
+                                reg const* r = reinterpret_cast<reg const*>(p);
+                                reg m[4] = { r[0], r[1], r[2], r[3] };
+
+                                transpose_quats<W, false>(m);
+
+                                quat<P> Result;
+
+                                for (size_t k = 0; k < 4; k++)
+                                        Result.data[k] = P::of(m[k]);
+
+                                return Result;
+                        };
+
+                        auto store = [] (quat<P> const& q, quat<T, Q>* p) VRT_KERNEL {
+                                reg m[4] = { q.data[0].v, q.data[1].v, q.data[2].v, q.data[3].v };
+
+                                transpose_quats<W, true>(m);
+
+                                for (size_t k = 0; k < 4; k++)
+                                        reinterpret_cast<reg*>(p)[k] = m[k];
+                        };
+
+                        size_t i = 0;
+
+                        for (; i + W <= n; i += W)
+                                store(f(load(a + i), load(b + i)), dst + i);
+
+                        for (; i < n; i++)
+                                dst[i] = f(a[i], b[i]);
+                }
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        void transform_points(mat<4, T, Q> const& m, vec<3, T, P> const* src, vec<3, T, P>* dst, size_t n)
+        {
+                detail::dispatch([&] () VRT_KERNEL {
+                        const T m00 = m[0].x, m01 = m[0].y, m02 = m[0].z;
+                        const T m10 = m[1].x, m11 = m[1].y, m12 = m[1].z;
+                        const T m20 = m[2].x, m21 = m[2].y, m22 = m[2].z;
+                        const T m30 = m[3].x, m31 = m[3].y, m32 = m[3].z;
+
+                        for (size_t i = 0; i < n; i++) {
+                                const T x = src[i].x, y = src[i].y, z = src[i].z;
+
+                                dst[i].x = m00 * x + m10 * y + m20 * z + m30;
+                                dst[i].y = m01 * x + m11 * y + m21 * z + m31;
+                                dst[i].z = m02 * x + m12 * y + m22 * z + m32;
+                        }
+                });
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        void transform_directions(mat<4, T, Q> const& m, vec<3, T, P> const* src, vec<3, T, P>* dst, size_t n)
+        {
+                detail::dispatch([&] () VRT_KERNEL {
+                        const T m00 = m[0].x, m01 = m[0].y, m02 = m[0].z;
+                        const T m10 = m[1].x, m11 = m[1].y, m12 = m[1].z;
+                        const T m20 = m[2].x, m21 = m[2].y, m22 = m[2].z;
+
+                        for (size_t i = 0; i < n; i++) {
+                                const T x = src[i].x, y = src[i].y, z = src[i].z;
+
+                                dst[i].x = m00 * x + m10 * y + m20 * z;
+                                dst[i].y = m01 * x + m11 * y + m21 * z;
+                                dst[i].z = m02 * x + m12 * y + m22 * z;
+                        }
+                });
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        void transform(mat<4, T, Q> const& m, vec<4, T, P> const* src, vec<4, T, P>* dst, size_t n)
+        {
+                detail::dispatch([&] () VRT_KERNEL {
+                        const T m00 = m[0].x, m01 = m[0].y, m02 = m[0].z, m03 = m[0].w;
+                        const T m10 = m[1].x, m11 = m[1].y, m12 = m[1].z, m13 = m[1].w;
+                        const T m20 = m[2].x, m21 = m[2].y, m22 = m[2].z, m23 = m[2].w;
+                        const T m30 = m[3].x, m31 = m[3].y, m32 = m[3].z, m33 = m[3].w;
+
+                        for (size_t i = 0; i < n; i++) {
+                                const T x = src[i].x, y = src[i].y, z = src[i].z, w = src[i].w;
+
+                                dst[i].x = m00 * x + m10 * y + m20 * z + m30 * w;
+                                dst[i].y = m01 * x + m11 * y + m21 * z + m31 * w;
+                                dst[i].z = m02 * x + m12 * y + m22 * z + m32 * w;
+                                dst[i].w = m03 * x + m13 * y + m23 * z + m33 * w;
+                        }
+                });
+        }
+
+        template<typename T, qualifier Q>
+        void rotate_x_deg(int const* angdeg, mat<4, T, Q>* dst, size_t n)
+        {
+                detail::dispatch([&] () VRT_KERNEL {
+                        for (size_t i = 0; i < n; i++)
+                                dst[i] = rotate_x_deg<T, Q>(angdeg[i]);
+                });
+        }
+
+        template<typename T, qualifier Q>
+        void rotate_y_deg(int const* angdeg, mat<4, T, Q>* dst, size_t n)
+        {
+                detail::dispatch([&] () VRT_KERNEL {
+                        for (size_t i = 0; i < n; i++)
+                                dst[i] = rotate_y_deg<T, Q>(angdeg[i]);
+                });
+        }
+
+        template<typename T, qualifier Q>
+        void rotate_z_deg(int const* angdeg, mat<4, T, Q>* dst, size_t n)
+        {
+                detail::dispatch([&] () VRT_KERNEL {
+                        for (size_t i = 0; i < n; i++)
+                                dst[i] = rotate_z_deg<T, Q>(angdeg[i]);
+                });
+        }
+
+        template<typename T, qualifier Q>
+        void nlerp(quat<T, Q> const* a, quat<T, Q> const* b, T t, quat<T, Q>* dst, size_t n)
+        {
+                detail::dispatch_wide<T>([&] (auto w) VRT_KERNEL {
+                        detail::blend_quats<decltype(w)::value>(a, b, dst, n, [t] (auto const& qa, auto const& qb) VRT_KERNEL {
+                                typedef std::remove_cvref_t<decltype(qa.x)> U;
+                                return nlerp(qa, qb, U(t));
+                        });
+                });
+        }
+
+        template<typename T, qualifier Q>
+        void slerp(quat<T, Q> const* a, quat<T, Q> const* b, T t, quat<T, Q>* dst, size_t n)
+        {
+                detail::dispatch_wide<T>([&] (auto w) VRT_KERNEL {
+                        detail::blend_quats<decltype(w)::value>(a, b, dst, n, [t] (auto const& qa, auto const& qb) VRT_KERNEL {
+                                typedef std::remove_cvref_t<decltype(qa.x)> U;
+                                return slerp(qa, qb, U(t));
+                        });
+                });
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        void skin_dualquat(dualquat<T, Q> const* bones, vec<4, int> const* joints, vec<4, T> const* weights,
+                           vec<3, T, P> const* src, vec<3, T, P>* dst,
+                           vec<3, T, P> const* normals, vec<3, T, P>* dst_normals, size_t n)
+        {
+                detail::dispatch([&] () VRT_KERNEL {
+                        for (size_t i = 0; i < n; i++) {
+                                dualquat<T, Q> const& b0 = bones[joints[i].x];
+                                dualquat<T, Q> const& b1 = bones[joints[i].y];
+                                dualquat<T, Q> const& b2 = bones[joints[i].z];
+                                dualquat<T, Q> const& b3 = bones[joints[i].w];
+
+                                /* q 与 -q 表示同一旋转，与第一个骨骼同向后再混合 */
+                                T w0 = weights[i].x;
+                                T w1 = dot(b0.real, b1.real) < 0 ? -weights[i].y : weights[i].y;
+                                T w2 = dot(b0.real, b2.real) < 0 ? -weights[i].z : weights[i].z;
+                                T w3 = dot(b0.real, b3.real) < 0 ? -weights[i].w : weights[i].w;
+
+                                T rw = b0.real.w * w0 + b1.real.w * w1 + b2.real.w * w2 + b3.real.w * w3;
+                                T rx = b0.real.x * w0 + b1.real.x * w1 + b2.real.x * w2 + b3.real.x * w3;
+                                T ry = b0.real.y * w0 + b1.real.y * w1 + b2.real.y * w2 + b3.real.y * w3;
+                                T rz = b0.real.z * w0 + b1.real.z * w1 + b2.real.z * w2 + b3.real.z * w3;
+
+                                T dw = b0.dual.w * w0 + b1.dual.w * w1 + b2.dual.w * w2 + b3.dual.w * w3;
+                                T dx = b0.dual.x * w0 + b1.dual.x * w1 + b2.dual.x * w2 + b3.dual.x * w3;
+                                T dy = b0.dual.y * w0 + b1.dual.y * w1 + b2.dual.y * w2 + b3.dual.y * w3;
+                                T dz = b0.dual.z * w0 + b1.dual.z * w1 + b2.dual.z * w2 + b3.dual.z * w3;
+
+                                /* 除以 real 的长度；dual 中与 real 平行的分量不影响下面的平移公式 */
+                                T inv = T(1) / sqrt(rw * rw + rx * rx + ry * ry + rz * rz);
+
+                                rw *= inv; rx *= inv; ry *= inv; rz *= inv;
+                                dw *= inv; dx *= inv; dy *= inv; dz *= inv;
+
+                                /* 平移 t = 2 * (w * d - dw * r + cross(r, d)) */
+                                T tx = 2 * (rw * dx - dw * rx + ry * dz - rz * dy);
+                                T ty = 2 * (rw * dy - dw * ry + rz * dx - rx * dz);
+                                T tz = 2 * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+                                /* 旋转使用两次叉积：v' = v + w * c + cross(r, c)，c = 2 * cross(r, v) */
+                                T px = src[i].x, py = src[i].y, pz = src[i].z;
+
+                                T cx = 2 * (ry * pz - rz * py);
+                                T cy = 2 * (rz * px - rx * pz);
+                                T cz = 2 * (rx * py - ry * px);
+
+                                dst[i].x = px + rw * cx + (ry * cz - rz * cy) + tx;
+                                dst[i].y = py + rw * cy + (rz * cx - rx * cz) + ty;
+                                dst[i].z = pz + rw * cz + (rx * cy - ry * cx) + tz;
+
+                                if (normals) {
+                                        T nx = normals[i].x, ny = normals[i].y, nz = normals[i].z;
+
+                                        T ex = 2 * (ry * nz - rz * ny);
+                                        T ey = 2 * (rz * nx - rx * nz);
+                                        T ez = 2 * (rx * ny - ry * nx);
+
+                                        dst_normals[i].x = nx + rw * ex + (ry * ez - rz * ey);
+                                        dst_normals[i].y = ny + rw * ey + (rz * ex - rx * ez);
+                                        dst_normals[i].z = nz + rw * ez + (rx * ey - ry * ex);
+                                }
+                        }
+                });
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        void skin_dualquat(dualquat<T, Q> const* bones, vec<4, int> const* joints, vec<4, T> const* weights,
+                           vec<3, T, P> const* src, vec<3, T, P>* dst, size_t n)
+        {
+                skin_dualquat(bones, joints, weights, src, dst, static_cast<vec<3, T, P> const*>(nullptr), static_cast<vec<3, T, P>*>(nullptr), n);
+        }
+
+        template<typename T, qualifier Q>
+        void inverse(mat<4, T, Q> const* src, mat<4, T, Q>* dst, size_t n)
+        {
+                detail::dispatch_wide<T>([&] (auto w) VRT_KERNEL {
+                        typedef detail::wide<T, decltype(w)::value> P;
+                        constexpr size_t W = P::size();
+
+                        size_t i = 0;
+
+                        for (; i + W <= n; i += W) {
+                                mat<4, P> m;
+
+                                for (int c = 0; c < 4; c++)
+                                        for (int r = 0; r < 4; r++)
+                                                m[c][r] = P([&](auto j) { return src[i + j][c][r]; });
+
+                                P det;
+                                mat<4, P> adj = detail::adjugate(m, det);
+                                P inv = P(1) / det;
+
+                                for (size_t j = 0; j < W; j++)
+                                        for (int c = 0; c < 4; c++)
+                                                for (int r = 0; r < 4; r++)
+                                                        dst[i + j][c][r] = adj[c][r][j] * inv[j];
+                        }
+
+                        for (; i < n; i++) {
+                                T det;
+                                mat<4, T, Q> adj = detail::adjugate(src[i], det);
+                                T inv = T(1) / det;
+
+                                for (int c = 0; c < 4; c++)
+                                        dst[i][c] = adj[c] * inv;
+                        }
+                });
+        }
+
+        namespace detail
+        {
+                template<typename F>
+                VRT_FUNC_DECL VRT_INLINE void parallel_for(size_t n, unsigned threads, F const& f)
+                {
+                        if (threads == 0)
+                                threads = std::max(1u, std::thread::hardware_concurrency());
+
+                        size_t count = std::min<size_t>(threads, n / VRT_BATCH_GRAIN);
+
+                        if (count <= 1) {
+                                f(size_t(0), n);
+                                return;
+                        }
+
+                        size_t step = (n + count - 1) / count;
+
+                        /* jthread 析构时 join：线程创建中途或调用线程的 f 抛出异常时，已启动的线程先结束再传播异常，
+                           而不是析构可 join 的 std::thread 调用 std::terminate */
+                        std::vector<std::jthread> workers;
+
+                        /* 调用线程处理第一段，其余各起一个线程 */
+                        for (size_t begin = step; begin < n; begin += step)
+                                workers.emplace_back(f, begin, std::min(begin + step, n));
+
+                        f(size_t(0), step);
+                }
+
+#if VRT_DISPATCH
+                /*
+                 * D = Σ A 的第 k 列 * B 每列的第 k 行，W 为一个寄存器的 float 个数（装下 W / 4 列）。
+                 * 使用 GCC 向量扩展而不是 intrinsic，内联进跳板后按其指令集生成代码：AVX-512 下整个矩阵为一个寄存器，
+                 * A 的列复制到每 4 个通道（vshuff32x4），B 的元素在每 4 个通道内广播（vpermilps）。
+                 */
+                template<size_t W, bool VA, bool VB, size_t... I>
+                VRT_FUNC_DECL VRT_INLINE VRT_KERNEL void mul_mat4(float const* a, float const* b, float* dst, size_t n, std::index_sequence<I...>)
+                {
+                        typedef float v __attribute__((vector_size(W * sizeof(float))));
+
+                        v ca[4];
+
+                        /* 只在同宽度的向量内重排，避免不同宽度之间经栈中转 */
+                        auto splat = [&] (float const* p) VRT_KERNEL {
+                                v m[16 / W];
+
+                                for (size_t j = 0; j < 16 / W; j++)
+                                        __builtin_memcpy(&m[j], p + W * j, sizeof(v));
+
+                                ca[0] = __builtin_shufflevector(m[0], m[0], (I % 4)...);
+                                ca[1] = __builtin_shufflevector(m[4 / W], m[4 / W], (I % 4 + 4 % W)...);
+                                ca[2] = __builtin_shufflevector(m[8 / W], m[8 / W], (I % 4 + 8 % W)...);
+                                ca[3] = __builtin_shufflevector(m[12 / W], m[12 / W], (I % 4 + 12 % W)...);
+                        };
+
+                        if constexpr (!VA)
+                                splat(a);
+
+                        for (size_t i = 0; i < n; i++) {
+                                if constexpr (VA)
+                                        splat(a + 16 * i);
+
+                                for (size_t g = 0; g < 16; g += W) {
+                                        v x;
+                                        __builtin_memcpy(&x, b + (VB ? 16 * i : 0) + g, sizeof(x));
+
+                                        v r = ca[0] * __builtin_shufflevector(x, x, (I / 4 * 4)...)
+                                            + ca[1] * __builtin_shufflevector(x, x, (I / 4 * 4 + 1)...)
+                                            + ca[2] * __builtin_shufflevector(x, x, (I / 4 * 4 + 2)...)
+                                            + ca[3] * __builtin_shufflevector(x, x, (I / 4 * 4 + 3)...);
+
+                                        __builtin_memcpy(dst + 16 * i + g, &r, sizeof(r));
+                                }
+                        }
+                }
+#endif
+
+                template<bool VA, bool VB, typename T, qualifier Q>
+                void multiply(mat<4, T, Q> const* a, mat<4, T, Q> const* b, mat<4, T, Q>* dst, size_t n, unsigned threads)
+                {
+                        parallel_for(n, threads, [=] (size_t begin, size_t end) {
+                                mat<4, T, Q> const* pa = VA ? a + begin : a;
+                                mat<4, T, Q> const* pb = VB ? b + begin : b;
+                                mat<4, T, Q>* pd = dst + begin;
+                                size_t count = end - begin;
+#if VRT_DISPATCH
+                                /* 16 个 float 连续存放（aligned32 的 vec4 会补齐到 32 字节，不在此列） */
+                                if constexpr (std::is_same_v<T, float> && sizeof(mat<4, T, Q>) == 16 * sizeof(float)) {
+                                        float const* fa = reinterpret_cast<float const*>(pa);
+                                        float const* fb = reinterpret_cast<float const*>(pb);
+                                        float* fd = reinterpret_cast<float*>(pd);
+
+                                        switch (dispatch_isa()) {
+                                                case isa_avx512: run_avx512([&] () VRT_KERNEL { mul_mat4<16, VA, VB>(fa, fb, fd, count, std::make_index_sequence<16>()); }); break;
+                                                case isa_avx2:   run_avx2([&] () VRT_KERNEL { mul_mat4<8, VA, VB>(fa, fb, fd, count, std::make_index_sequence<8>()); }); break;
+                                                case isa_sse42:  run_sse42([&] () VRT_KERNEL { mul_mat4<4, VA, VB>(fa, fb, fd, count, std::make_index_sequence<4>()); }); break;
+                                                default:         run_default([&] () VRT_KERNEL { mul_mat4<4, VA, VB>(fa, fb, fd, count, std::make_index_sequence<4>()); }); break;
+                                        }
+
+                                        return;
+                                }
+#endif
+                                dispatch([&] () VRT_KERNEL {
+                                        for (size_t i = 0; i < count; i++)
+                                                pd[i] = pa[VA ? i : 0] * pb[VB ? i : 0];
+                                });
+                        });
+                }
+        }
+
+        template<typename T, qualifier Q>
+        void multiply(mat<4, T, Q> const& a, mat<4, T, Q> const* b, mat<4, T, Q>* dst, size_t n, unsigned threads)
+        {
+                detail::multiply<false, true>(&a, b, dst, n, threads);
+        }
+
+        template<typename T, qualifier Q>
+        void multiply(mat<4, T, Q> const* a, mat<4, T, Q> const& b, mat<4, T, Q>* dst, size_t n, unsigned threads)
+        {
+                detail::multiply<true, false>(a, &b, dst, n, threads);
+        }
+
+        template<typename T, qualifier Q>
+        void multiply(mat<4, T, Q> const* a, mat<4, T, Q> const* b, mat<4, T, Q>* dst, size_t n, unsigned threads)
+        {
+                detail::multiply<true, true>(a, b, dst, n, threads);
+        }
+}
+
+#endif /* VRT_BATCH_H_ */
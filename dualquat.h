@@ -0,0 +1,226 @@
+/* -------------------------------------------------------------------------------- *\
+|*                                                                                  *|
+|*    Copyright (C) 2019-2024 RedGogh All rights reserved.                          *|
+|*                                                                                  *|
+|*    Licensed under the Apache License, Version 2.0 (the "License");               *|
+|*    you may not use this file except in compliance with the License.              *|
+|*    You may obtain a copy of the License at                                       *|
+|*                                                                                  *|
+|*        http://www.apache.org/licenses/LICENSE-2.0                                *|
+|*                                                                                  *|
+|*    Unless required by applicable law or agreed to in writing, software           *|
+|*    distributed under the License is distributed on an "AS IS" BASIS,             *|
+|*    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.      *|
+|*    See the License for the specific language governing permissions and           *|
+|*    limitations under the License.                                                *|
+|*                                                                                  *|
+\* -------------------------------------------------------------------------------- */
+#ifndef VRT_DUALQUAT_H_
+#define VRT_DUALQUAT_H_
+
+#include "quat.h"
+
+///
+/// 对偶四元数。
+///
+/// 单位对偶四元数 real + ε dual 表示刚体变换（旋转 + 平移）：real 为旋转，dual = 0.5 * (0, t) * real。
+/// 每个骨骼只需 8 个分量（mat4 为 16 个），线性混合后归一化（DLB）仍是刚体变换，
+/// 蒙皮时不会出现线性混合矩阵的体积塌陷（candy-wrapper）。接口参考 glm 的 gtx/dual_quaternion.hpp。
+///
+///     dualquatf32 bone(angle_axis(30.0f, vec3(0, 1, 0)), vec3(0, 2, 0));
+///     vec3 p = transform_point(bone, v);
+///
+namespace vrt
+{
+        ///
+        /// @brief 对偶四元数 real + ε dual。
+        ///
+        /// @tparam T 浮点数类型
+        /// @tparam Q 存储限定符
+        ///
+        template<typename T, qualifier Q = packed>
+        struct dualquat {
+                // -- Data --
+
+                quat<T, Q> real;
+                quat<T, Q> dual;
+
+                // -- Constructor --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR dualquat() VRT_FUNC_DEFAULT_CTOR;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR dualquat(quat<T, Q> const& real, quat<T, Q> const& dual);
+
+                /* 先旋转 r，再平移 t 的刚体变换 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR dualquat(quat<T, Q> const& r, vec<3, T, Q> const& t);
+
+                /* 从刚体变换矩阵（旋转 + 平移，不含缩放与切变）构造 */
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit dualquat(mat<4, T, P> const& m);
+
+                // -- Conversion --
+
+                /* 单位对偶四元数对应的刚体变换矩阵 */
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit operator mat<4, T, P>() const;
+
+        };
+
+        // -- typedef --
+
+        typedef struct dualquat<float> dualquatf32;
+        typedef struct dualquat<double> dualquatf64;
+
+        // -- struct dualquat<T>: Global operator overrides --
+
+        ///
+        /// @brief 复合两个刚体变换 a * b（先 b 后 a）：real = a.real * b.real，dual = a.real * b.dual + a.dual * b.real。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR dualquat<T, Q> operator*(dualquat<T, Q> const& a, dualquat<T, Q> const& b);
+
+        /* 逐分量加法与数乘，用于加权混合 */
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR dualquat<T, Q> operator+(dualquat<T, Q> const& a, dualquat<T, Q> const& b);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR dualquat<T, Q> operator*(dualquat<T, Q> const& a, T s);
+
+        // -- Functions --
+
+        ///
+        /// @brief 归一化对偶四元数：real 缩放为单位长度，dual 去掉与 real 平行的分量。
+        ///
+        /// 加权混合或多次复合后调用，使结果重新成为刚体变换。real 不能为零四元数。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR dualquat<T, Q> normalize(dualquat<T, Q> const& dq);
+
+        ///
+        /// @brief 单位对偶四元数的平移部分：2 * (dual * conjugate(real)).xyz。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> translation(dualquat<T, Q> const& dq);
+
+        ///
+        /// @brief 单位对偶四元数的逆变换：real 与 dual 分别取共轭。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR dualquat<T, Q> inverse(dualquat<T, Q> const& dq);
+
+        ///
+        /// @brief 使用单位对偶四元数变换一个点：rotate(real, p) + translation(dq)。
+        ///
+        /// @see transform_direction()
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> transform_point(dualquat<T, Q> const& dq, vec<3, T, P> const& p);
+
+        ///
+        /// @brief 使用单位对偶四元数变换一个方向向量，只旋转不平移。
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> transform_direction(dualquat<T, Q> const& dq, vec<3, T, P> const& d);
+
+        // -- struct dualquat<T>: implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q>::dualquat(quat<T, Q> const& real, quat<T, Q> const& dual)
+                : real(real), dual(dual)
+        {}
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q>::dualquat(quat<T, Q> const& r, vec<3, T, Q> const& t)
+                : real(r), dual(quat<T, Q>(0, t * T(0.5)) * r)
+        {}
+
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q>::dualquat(mat<4, T, P> const& m)
+                : dualquat(quat<T, Q>(m), vec<3, T, Q>(m[3].x, m[3].y, m[3].z))
+        {}
+
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q>::operator mat<4, T, P>() const
+        {
+                mat<4, T, P> Result(real);
+                vec<3, T, Q> t = translation(*this);
+
+                Result[3] = vec<4, T, P>(t.x, t.y, t.z, 1);
+
+                return Result;
+        }
+
+        // -- struct dualquat<T>: Global operator implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q> operator*(dualquat<T, Q> const& a, dualquat<T, Q> const& b)
+        {
+                quat<T, Q> d0 = a.real * b.dual;
+                quat<T, Q> d1 = a.dual * b.real;
+
+                return dualquat<T, Q>(a.real * b.real, quat<T, Q>(d0.w + d1.w, d0.x + d1.x, d0.y + d1.y, d0.z + d1.z));
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q> operator+(dualquat<T, Q> const& a, dualquat<T, Q> const& b)
+        {
+                return dualquat<T, Q>(quat<T, Q>(a.real.w + b.real.w, a.real.x + b.real.x, a.real.y + b.real.y, a.real.z + b.real.z),
+                                      quat<T, Q>(a.dual.w + b.dual.w, a.dual.x + b.dual.x, a.dual.y + b.dual.y, a.dual.z + b.dual.z));
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q> operator*(dualquat<T, Q> const& a, T s)
+        {
+                return dualquat<T, Q>(quat<T, Q>(a.real.w * s, a.real.x * s, a.real.y * s, a.real.z * s),
+                                      quat<T, Q>(a.dual.w * s, a.dual.x * s, a.dual.y * s, a.dual.z * s));
+        }
+
+        // -- Functions implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q> normalize(dualquat<T, Q> const& dq)
+        {
+                T inv = T(1) / sqrt(dot(dq.real, dq.real));
+
+                quat<T, Q> r(dq.real.w * inv, dq.real.x * inv, dq.real.y * inv, dq.real.z * inv);
+                quat<T, Q> d(dq.dual.w * inv, dq.dual.x * inv, dq.dual.y * inv, dq.dual.z * inv);
+
+                /* 单位对偶四元数满足 dot(real, dual) = 0 */
+                T k = dot(r, d);
+
+                return dualquat<T, Q>(r, quat<T, Q>(d.w - r.w * k, d.x - r.x * k, d.y - r.y * k, d.z - r.z * k));
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> translation(dualquat<T, Q> const& dq)
+        {
+                /* 2 * (dual * conjugate(real)) 的向量部分展开 */
+                vec<3, T, Q> r = dq.real.xyz();
+                vec<3, T, Q> d = dq.dual.xyz();
+
+                return (d * dq.real.w - r * dq.dual.w + cross(r, d)) * T(2);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR dualquat<T, Q> inverse(dualquat<T, Q> const& dq)
+        {
+                return dualquat<T, Q>(conjugate(dq.real), conjugate(dq.dual));
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> transform_point(dualquat<T, Q> const& dq, vec<3, T, P> const& p)
+        {
+                vec<3, T, Q> t = translation(dq);
+
+                return rotate(dq.real, p) + vec<3, T, P>(t.x, t.y, t.z);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> transform_direction(dualquat<T, Q> const& dq, vec<3, T, P> const& d)
+        {
+                return rotate(dq.real, d);
+        }
+}
+
+#endif /* VRT_DUALQUAT_H_ */
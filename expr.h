@@ -0,0 +1,276 @@
+/* -------------------------------------------------------------------------------- *\
+|*                                                                                  *|
+|*    Copyright (C) 2019-2024 RedGogh All rights reserved.                          *|
+|*                                                                                  *|
+|*    Licensed under the Apache License, Version 2.0 (the "License");               *|
+|*    you may not use this file except in compliance with the License.              *|
+|*    You may obtain a copy of the License at                                       *|
+|*                                                                                  *|
+|*        http://www.apache.org/licenses/LICENSE-2.0                                *|
+|*                                                                                  *|
+|*    Unless required by applicable law or agreed to in writing, software           *|
+|*    distributed under the License is distributed on an "AS IS" BASIS,             *|
+|*    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.      *|
+|*    See the License for the specific language governing permissions and           *|
+|*    limitations under the License.                                                *|
+|*                                                                                  *|
+\* -------------------------------------------------------------------------------- */
+#ifndef VRT_EXPR_H_
+#define VRT_EXPR_H_
+
+#include "vec.h"
+// std
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+///
+/// 可选的向量表达式模板。
+///
+/// 使用 lazy() 包装向量后，+ - * / 不再立即生成临时 vec，而是构造表达式树，
+/// 在赋值（转换为 vec）时逐分量只求值一次，并将 x * y + z 形式映射为融合乘加（FMA）：
+///
+///     vec3 p1 = lazy(p) + lazy(v) * dt + lazy(a) * (0.5f * dt * dt);
+///
+/// 上式展开为每个分量两次乘加，没有任何中间向量。只有硬件支持快速 FMA（定义了 FP_FAST_FMAF / FP_FAST_FMA，
+/// 例如 -mfma 或 -march=native）时乘加才是单条 fma；默认构建下是普通的先乘后加，结果与直接写 vec 运算相同。
+///
+/// @warning 表达式只保存被包装向量的引用，不要用 auto 保存表达式并在语句结束后求值。
+///
+namespace vrt
+{
+        template<size_t N, typename T, qualifier Q, typename E>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& assign(vec<N, T, Q>& dst, E const& e);
+
+        namespace expr
+        {
+                // -- node --
+
+                template<typename E>
+                struct node {
+                        /* 赋值或初始化 vec 时对整个表达式求值 */
+                        template<size_t N, typename T, qualifier Q>
+                        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR operator vec<N, T, Q>() const
+                        {
+                                vec<N, T, Q> Result;
+                                return assign(Result, static_cast<E const&>(*this));
+                        }
+                };
+
+                template<typename E>
+                inline constexpr bool is_node_v = std::is_base_of_v<node<E>, E>;
+
+                template<typename E>
+                inline constexpr bool is_operand_v = is_node_v<E> || std::is_arithmetic_v<E>;
+
+                // -- terminals --
+
+                template<size_t N, typename T, qualifier Q>
+                struct terminal : node<terminal<N, T, Q>> {
+                        static constexpr size_t size = N;
+
+                        vec<N, T, Q> const& v;
+
+                        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T operator[](size_t i) const { return v[i]; }
+                };
+
+                template<typename T>
+                struct scalar : node<scalar<T>> {
+                        static constexpr size_t size = 0; /* 广播到任意长度 */
+
+                        T s;
+
+                        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T operator[](size_t) const { return s; }
+                };
+
+                // -- operators --
+
+                struct add { template<typename A, typename B> static VRT_FUNC_CONSTEXPR auto apply(A a, B b) { return a + b; } };
+                struct sub { template<typename A, typename B> static VRT_FUNC_CONSTEXPR auto apply(A a, B b) { return a - b; } };
+                struct mul { template<typename A, typename B> static VRT_FUNC_CONSTEXPR auto apply(A a, B b) { return a * b; } };
+                struct div { template<typename A, typename B> static VRT_FUNC_CONSTEXPR auto apply(A a, B b) { return a / b; } };
+
+                template<typename A, typename B>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR size_t merge_size()
+                {
+                        static_assert(A::size == 0 || B::size == 0 || A::size == B::size, "vector size mismatch");
+                        return A::size > B::size ? A::size : B::size;
+                }
+
+                template<typename Op, typename A, typename B>
+                struct binary : node<binary<Op, A, B>> {
+                        static constexpr size_t size = merge_size<A, B>();
+
+                        A a;
+                        B b;
+
+                        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto operator[](size_t i) const { return Op::apply(a[i], b[i]); }
+                };
+
+                template<typename A>
+                struct negate : node<negate<A>> {
+                        static constexpr size_t size = A::size;
+
+                        A a;
+
+                        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto operator[](size_t i) const { return -a[i]; }
+                };
+
+                /* a * b + c */
+                template<typename A, typename B, typename C>
+                struct fused : node<fused<A, B, C>> {
+                        static constexpr size_t size = merge_size<binary<mul, A, B>, C>();
+
+                        A a;
+                        B b;
+                        C c;
+
+                        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto operator[](size_t i) const
+                        {
+                                auto x = a[i];
+                                auto y = b[i];
+                                auto z = c[i];
+
+                                typedef std::common_type_t<decltype(x), decltype(y), decltype(z)> R;
+
+                                /* 仅在硬件支持快速 FMA 时调用 std::fma，否则退化为普通乘加，避免软件 fma 的开销 */
+                                if !consteval {
+#if defined(FP_FAST_FMAF)
+                                        if constexpr (std::is_same_v<R, float>)
+                                                return std::fma(R(x), R(y), R(z));
+#endif
+#if defined(FP_FAST_FMA)
+                                        if constexpr (std::is_same_v<R, double>)
+                                                return std::fma(R(x), R(y), R(z));
+#endif
+                                }
+
+                                return R(x) * R(y) + R(z);
+                        }
+                };
+
+                template<typename E>
+                struct is_mul : std::false_type {};
+
+                template<typename A, typename B>
+                struct is_mul<binary<mul, A, B>> : std::true_type {};
+
+                template<typename E>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto wrap(E const& e)
+                {
+                        if constexpr (is_node_v<E>)
+                                return e;
+                        else
+                                return scalar<E>{ {}, e };
+                }
+
+                template<typename A, typename B>
+                requires (is_operand_v<A> && is_operand_v<B> && (is_node_v<A> || is_node_v<B>))
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto operator+(A const& a, B const& b)
+                {
+                        auto l = wrap(a);
+                        auto r = wrap(b);
+
+                        if constexpr (is_mul<decltype(l)>::value)
+                                return fused<decltype(l.a), decltype(l.b), decltype(r)>{ {}, l.a, l.b, r };
+                        else if constexpr (is_mul<decltype(r)>::value)
+                                return fused<decltype(r.a), decltype(r.b), decltype(l)>{ {}, r.a, r.b, l };
+                        else
+                                return binary<add, decltype(l), decltype(r)>{ {}, l, r };
+                }
+
+                template<typename A, typename B>
+                requires (is_operand_v<A> && is_operand_v<B> && (is_node_v<A> || is_node_v<B>))
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto operator-(A const& a, B const& b)
+                {
+                        auto l = wrap(a);
+                        auto r = wrap(b);
+
+                        if constexpr (is_mul<decltype(l)>::value)
+                                return fused<decltype(l.a), decltype(l.b), negate<decltype(r)>>{ {}, l.a, l.b, { {}, r } };
+                        else if constexpr (is_mul<decltype(r)>::value)
+                                return fused<negate<decltype(r.a)>, decltype(r.b), decltype(l)>{ {}, { {}, r.a }, r.b, l };
+                        else
+                                return binary<sub, decltype(l), decltype(r)>{ {}, l, r };
+                }
+
+                template<typename A, typename B>
+                requires (is_operand_v<A> && is_operand_v<B> && (is_node_v<A> || is_node_v<B>))
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto operator*(A const& a, B const& b)
+                {
+                        auto l = wrap(a);
+                        auto r = wrap(b);
+
+                        return binary<mul, decltype(l), decltype(r)>{ {}, l, r };
+                }
+
+                template<typename A, typename B>
+                requires (is_operand_v<A> && is_operand_v<B> && (is_node_v<A> || is_node_v<B>))
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto operator/(A const& a, B const& b)
+                {
+                        auto l = wrap(a);
+                        auto r = wrap(b);
+
+                        return binary<div, decltype(l), decltype(r)>{ {}, l, r };
+                }
+
+                template<typename A>
+                requires is_node_v<A>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto operator-(A const& a)
+                {
+                        return negate<A>{ {}, a };
+                }
+        }
+
+        ///
+        /// @brief 将向量包装为表达式的叶子节点，开启延迟求值。
+        ///
+        /// @param v 被引用的向量，生命周期必须覆盖表达式的求值
+        /// @return expr::terminal 表达式叶子节点
+        ///
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR expr::terminal<N, T, Q> lazy(vec<N, T, Q> const& v)
+        {
+                return expr::terminal<N, T, Q>{ {}, v };
+        }
+
+        ///
+        /// @brief 对表达式逐分量求值并写入目标向量。
+        ///
+        /// 表达式只包含逐分量运算，因此目标向量也可以出现在表达式中（例如 p = p + v * dt）。
+        ///
+        /// @param dst 目标向量
+        /// @param e 表达式
+        /// @return vec<N, T, Q>& 返回 dst
+        ///
+        template<size_t N, typename T, qualifier Q, typename E>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q>& assign(vec<N, T, Q>& dst, E const& e)
+        {
+                static_assert(E::size == N, "vector size mismatch");
+
+                /* 按分量展开，保证结果留在寄存器中 */
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                        ((dst[I] = static_cast<T>(e[I])), ...);
+                }(std::make_index_sequence<N>{});
+
+                return dst;
+        }
+
+        ///
+        /// @brief 对表达式求值，返回新的向量。
+        ///
+        /// @param e 表达式
+        /// @return vec<E::size, T> 求值结果，T 为表达式分量的类型
+        ///
+        template<typename E>
+        requires expr::is_node_v<E>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR auto eval(E const& e)
+        {
+                typedef std::remove_cvref_t<decltype(e[0])> T;
+
+                vec<E::size, T> Result;
+                return assign(Result, e);
+        }
+}
+
+#endif /* VRT_EXPR_H_ */
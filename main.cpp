@@ -39,6 +39,8 @@ void *call(void *ptr)
 
 int main()
 {
+        printf("vrt dispatch: %s\n", vrt::isa_name(vrt::dispatch_isa()));
+
         static std::vector<std::array<float, 3>> numbers;
         
         for (int i =0; i < 3; i++)
@@ -79,6 +81,827 @@ int main()
                         call(&v);
                 }
         });
+
+        static std::vector<std::array<float, 16>> matrices;
+
+        for (int i = 0; i < 1024; i++)
+                matrices.push_back(random_float16());
+
+        performance("vrt mat4 * mat4", []{
+                using namespace vrt;
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat4> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 10000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = m[i] * m[(i + n) % m.size()];
+
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        performance("glm mat4 * mat4", []{
+                using namespace glm;
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat4> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 10000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = m[i] * m[(i + n) % m.size()];
+
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        performance("vrt mat4f64 * mat4f64", []{
+                using namespace vrt;
+
+                std::vector<mat4f64> m(matrices.size());
+                std::vector<mat4f64> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        for (int k = 0; k < 16; k++)
+                                m[i][k / 4][k % 4] = matrices[i][k];
+
+                for (int n = 0; n < 10000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = m[i] * m[(i + n) % m.size()];
+
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        performance("glm dmat4 * dmat4", []{
+                using namespace glm;
+
+                std::vector<dmat4> m(matrices.size());
+                std::vector<dmat4> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        for (int k = 0; k < 16; k++)
+                                m[i][k / 4][k % 4] = matrices[i][k];
+
+                for (int n = 0; n < 10000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = m[i] * m[(i + n) % m.size()];
+
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        static std::vector<std::array<float, 3>> points;
+
+        for (int i = 0; i < 4096; i++)
+                points.push_back(random_float3());
+
+        performance("vrt p + v * dt + a * (0.5 * dt * dt)", []{
+                using namespace vrt;
+
+                std::vector<vec3> p(points.size(), vec3(0.0f));
+                float dt = 0.001f;
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < p.size(); i++) {
+                                vec3 v(points[i][0], points[i][1], points[i][2]);
+                                vec3 a(points[i][2], points[i][0], points[i][1]);
+                                p[i] = p[i] + v * dt + a * (0.5f * dt * dt);
+                        }
+
+                VRT_PRINT_FORMAT_VECTOR3(p[0]);
+        });
+
+        performance("vrt lazy(p) + lazy(v) * dt + lazy(a) * (0.5 * dt * dt)", []{
+                using namespace vrt;
+
+                std::vector<vec3> p(points.size(), vec3(0.0f));
+                float dt = 0.001f;
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < p.size(); i++) {
+                                vec3 v(points[i][0], points[i][1], points[i][2]);
+                                vec3 a(points[i][2], points[i][0], points[i][1]);
+                                p[i] = lazy(p[i]) + lazy(v) * dt + lazy(a) * (0.5f * dt * dt);
+                        }
+
+                VRT_PRINT_FORMAT_VECTOR3(p[0]);
+        });
+
+        static std::vector<std::array<float, 16>> features;
+
+        for (int i = 0; i < 4096; i++)
+                features.push_back(random_float16());
+
+        performance("loop float[16] dot + blend", []{
+                std::vector<std::array<float, 16>> acc(features.size());
+                float sum = 0.0f;
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < features.size(); i++) {
+                                auto const& a = features[i];
+                                auto const& b = features[(i + n) % features.size()];
+
+                                float d = 0.0f;
+                                for (int k = 0; k < 16; k++)
+                                        d += a[k] * b[k];
+
+                                for (int k = 0; k < 16; k++)
+                                        acc[i][k] = acc[i][k] * 0.5f + b[k] * 0.001f;
+
+                                sum += d;
+                        }
+
+                printf("%f %f\n", sum, acc[0][0]);
+        });
+
+        performance("vrt vec16 dot + blend", []{
+                using namespace vrt;
+
+                std::vector<vec16> f(features.size());
+                std::vector<vec16> acc(features.size(), vec16(0.0f));
+                float sum = 0.0f;
+
+                for (size_t i = 0; i < features.size(); i++)
+                        std::memcpy(f[i].data, features[i].data(), sizeof(vec16));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < f.size(); i++) {
+                                vec16 const& b = f[(i + n) % f.size()];
+
+                                acc[i] = acc[i] * 0.5f + b * 0.001f;
+                                sum += dot(f[i], b);
+                        }
+
+                printf("%f %f\n", sum, acc[0][0]);
+        });
+
+        performance("vrt transform_point(mat4, vec3)", []{
+                using namespace vrt;
+
+                /* 常量求值时走逐分量的路径 */
+                constexpr mat4 cm = translate(scale(mat4(1.0f), vec3(2.0f)), vec3(1.0f, 2.0f, 3.0f));
+                constexpr vec3 cp = transform_point(cm, vec3(1.0f));
+                constexpr vec3 cd = transform_direction(cm, vec3(1.0f));
+
+                static_assert(cp.x == 4.0f && cp.y == 6.0f && cp.z == 8.0f);
+                static_assert(cd.x == 2.0f && cd.y == 2.0f && cd.z == 2.0f);
+
+                mat4 m = rotate(translate(mat4(1.0f), vec3(1.0f, 2.0f, 3.0f)), 30.0f, vec3(0.0f, 0.0f, 1.0f));
+                std::vector<vec3> p(points.size());
+                std::vector<vec3> r(points.size());
+
+                for (size_t i = 0; i < points.size(); i++)
+                        p[i] = vec3(points[i][0], points[i][1], points[i][2]);
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < p.size(); i++)
+                                r[i] = normalize(transform_point(m, p[i]));
+
+                VRT_PRINT_FORMAT_VECTOR3(r[0]);
+        });
+
+        performance("vrt transform_point(mat4_packet, vec3_packet)", []{
+                using namespace vrt;
+
+                constexpr size_t W = std::experimental::simd_size_v<float, std::experimental::simd_abi::native<float>>;
+
+                mat4 m = rotate(translate(mat4(1.0f), vec3(1.0f, 2.0f, 3.0f)), 30.0f, vec3(0.0f, 0.0f, 1.0f));
+                mat4_packet<W> mp;
+                std::vector<vec3_packet<W>> p(points.size() / W);
+                std::vector<vec3> r(points.size());
+
+                for (int i = 0; i < 4; i++)
+                        for (int j = 0; j < 4; j++)
+                                mp[i][j] = m[i][j];
+
+                for (size_t i = 0; i < p.size(); i++) {
+                        vec3 aos[W];
+                        for (size_t j = 0; j < W; j++)
+                                aos[j] = vec3(points[i * W + j][0], points[i * W + j][1], points[i * W + j][2]);
+                        p[i] = gather<W>(aos);
+                }
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < p.size(); i++)
+                                scatter(normalize(transform_point(mp, p[i])), &r[i * W]);
+
+                VRT_PRINT_FORMAT_VECTOR3(r[0]);
+        });
+
+        performance("vrt transform_points(mat4, vec3*, n)", []{
+                using namespace vrt;
+
+                mat4 m = rotate(translate(mat4(1.0f), vec3(1.0f, 2.0f, 3.0f)), 30.0f, vec3(0.0f, 0.0f, 1.0f));
+                std::vector<vec3> p(points.size());
+                std::vector<vec3> r(points.size());
+
+                for (size_t i = 0; i < points.size(); i++)
+                        p[i] = vec3(points[i][0], points[i][1], points[i][2]);
+
+                for (int n = 0; n < 1000; n++)
+                        transform_points(m, p.data(), r.data(), p.size());
+
+                VRT_PRINT_FORMAT_VECTOR3(r[0]);
+        });
+
+        performance("vrt normalize(vec3)", []{
+                using namespace vrt;
+
+                std::vector<vec3> r(points.size(), vec3(0.0f));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++)
+                                r[i] += normalize(vec3(points[i][0], points[i][1], points[i][2]));
+
+                VRT_PRINT_FORMAT_VECTOR3(r[0]);
+        });
+
+        performance("vrt fast_normalize(vec3)", []{
+                using namespace vrt;
+
+                std::vector<vec3> r(points.size(), vec3(0.0f));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++)
+                                r[i] += fast_normalize(vec3(points[i][0], points[i][1], points[i][2]));
+
+                VRT_PRINT_FORMAT_VECTOR3(r[0]);
+        });
+
+        performance("glm fastNormalize(vec3)", []{
+                using namespace glm;
+
+                std::vector<vec3> r(points.size(), vec3(0.0f));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++)
+                                r[i] += fastNormalize(vec3(points[i][0], points[i][1], points[i][2]));
+
+                VRT_PRINT_FORMAT_VECTOR3(r[0]);
+        });
+
+        performance("vrt normalize(vec3_packet)", []{
+                using namespace vrt;
+
+                constexpr size_t W = std::experimental::simd_size_v<float, std::experimental::simd_abi::native<float>>;
+
+                std::vector<vec3_packet<W>> p(points.size() / W);
+                std::vector<vec3_packet<W>> r(p.size(), vec3_packet<W>(packet<float, W>(0.0f)));
+
+                for (size_t i = 0; i < p.size(); i++) {
+                        vec3 aos[W];
+                        for (size_t j = 0; j < W; j++)
+                                aos[j] = vec3(points[i * W + j][0], points[i * W + j][1], points[i * W + j][2]);
+                        p[i] = gather<W>(aos);
+                }
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < p.size(); i++)
+                                r[i] += normalize(p[i]);
+
+                vec3 r0[W];
+                scatter(r[0], r0);
+
+                VRT_PRINT_FORMAT_VECTOR3(r0[0]);
+        });
+
+        performance("vrt fast_normalize(vec3_packet)", []{
+                using namespace vrt;
+
+                constexpr size_t W = std::experimental::simd_size_v<float, std::experimental::simd_abi::native<float>>;
+
+                std::vector<vec3_packet<W>> p(points.size() / W);
+                std::vector<vec3_packet<W>> r(p.size(), vec3_packet<W>(packet<float, W>(0.0f)));
+
+                for (size_t i = 0; i < p.size(); i++) {
+                        vec3 aos[W];
+                        for (size_t j = 0; j < W; j++)
+                                aos[j] = vec3(points[i * W + j][0], points[i * W + j][1], points[i * W + j][2]);
+                        p[i] = gather<W>(aos);
+                }
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < p.size(); i++)
+                                r[i] += fast_normalize(p[i]);
+
+                vec3 r0[W];
+                scatter(r[0], r0);
+
+                VRT_PRINT_FORMAT_VECTOR3(r0[0]);
+        });
+
+        performance("std::sin + std::cos", []{
+                std::vector<float> r(points.size(), 0.0f);
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++)
+                                r[i] += std::sin(points[i][0] + n) + std::cos(points[i][0] + n);
+
+                printf("%f\n", r[0]);
+        });
+
+        performance("vrt sincos(float)", []{
+                using namespace vrt;
+
+                std::vector<float> r(points.size(), 0.0f);
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++) {
+                                float s, c;
+                                sincos(points[i][0] + n, s, c);
+                                r[i] += s + c;
+                        }
+
+                printf("%f\n", r[0]);
+        });
+
+        performance("vrt sincos(packet)", []{
+                using namespace vrt;
+
+                constexpr size_t W = std::experimental::simd_size_v<float, std::experimental::simd_abi::native<float>>;
+
+                std::vector<packet<float, W>> r(points.size() / W, packet<float, W>(0.0f));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < r.size(); i++) {
+                                packet<float, W> x([&](auto j) { return points[i * W + j][0] + n; });
+                                packet<float, W> s, c;
+                                sincos(x, s, c);
+                                r[i] += s + c;
+                        }
+
+                printf("%f\n", float(r[0][0]));
+        });
+
+        performance("glm acos(dot(a, b) / (length(a) * length(b)))", []{
+                using namespace glm;
+
+                float sum = 0.0f;
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++) {
+                                auto const& a = points[i];
+                                auto const& b = points[(i + n) % points.size()];
+                                sum += acos(clamp(dot(vec3(a[0], a[1], a[2]), vec3(b[0], b[1], b[2]))
+                                                  / (length(vec3(a[0], a[1], a[2])) * length(vec3(b[0], b[1], b[2]))), -1.0f, 1.0f));
+                        }
+
+                printf("%f\n", sum);
+        });
+
+        performance("vrt angle(a, b)", []{
+                using namespace vrt;
+
+                float sum = 0.0f;
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++) {
+                                auto const& a = points[i];
+                                auto const& b = points[(i + n) % points.size()];
+                                sum += angle(vec3(a[0], a[1], a[2]), vec3(b[0], b[1], b[2]));
+                        }
+
+                printf("%f\n", sum);
+        });
+
+        performance("vrt fast_angle(vec3_packet, vec3_packet)", []{
+                using namespace vrt;
+
+                constexpr size_t W = std::experimental::simd_size_v<float, std::experimental::simd_abi::native<float>>;
+
+                packet<float, W> sum(0.0f);
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i + W <= points.size(); i += W) {
+                                vec3_packet<W> a, b;
+
+                                for (int k = 0; k < 3; k++) {
+                                        a[k] = packet<float, W>([&](auto j) { return points[i + j][k]; });
+                                        b[k] = packet<float, W>([&](auto j) { return points[(i + j + n) % points.size()][k]; });
+                                }
+
+                                sum += fast_angle(a, b);
+                        }
+
+                printf("%f\n", std::experimental::reduce(sum));
+        });
+
+        performance("std::pow(x, 2.2f)", []{
+                std::vector<float> r(points.size(), 0.0f);
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++)
+                                r[i] += std::pow(std::abs(points[i][0]) + n * 0.001f, 2.2f);
+
+                printf("%f\n", r[0]);
+        });
+
+        performance("vrt pow(packet, 2.2f)", []{
+                using namespace vrt;
+
+                constexpr size_t W = std::experimental::simd_size_v<float, std::experimental::simd_abi::native<float>>;
+
+                std::vector<packet<float, W>> r(points.size() / W, packet<float, W>(0.0f));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < r.size(); i++) {
+                                packet<float, W> x([&](auto j) { return std::abs(points[i * W + j][0]) + n * 0.001f; });
+                                r[i] += pow(x, packet<float, W>(2.2f));
+                        }
+
+                printf("%f\n", float(r[0][0]));
+        });
+
+        performance("rotate(mat4, float, vec3)", []{
+                float r = 0.0f;
+
+                for (int n = 0; n < 10000000; n++)
+                        r += vrt::rotate(vrt::mat4(1.0f), float(n % 360), vrt::vec3(0, 0, 1))[0][1];
+
+                printf("%f\n", r);
+        });
+
+        performance("rotate(mat4, int, vec3)", []{
+                float r = 0.0f;
+
+                for (int n = 0; n < 10000000; n++)
+                        r += vrt::rotate(vrt::mat4(1.0f), n % 360, vrt::vec3(0, 0, 1))[0][1];
+
+                printf("%f\n", r);
+        });
+
+        performance("m * translate * scale (full mat4)", []{
+                vrt::mat4 m(1.0f);
+
+                for (int n = 0; n < 10000000; n++) {
+                        vrt::mat4 t(1.0f), s(1.0f);
+                        t[3] = vrt::vec4(0.001f, 0.0f, -0.001f, 1.0f);
+                        s[0][0] = s[1][1] = s[2][2] = 1.0000001f;
+                        m = m * t * s;
+                }
+
+                printf("%f\n", m[3][0]);
+        });
+
+        performance("translate_inplace + scale_inplace", []{
+                vrt::mat4 m(1.0f);
+
+                for (int n = 0; n < 10000000; n++) {
+                        vrt::translate_inplace(m, vrt::vec3(0.001f, 0.0f, -0.001f));
+                        vrt::scale_inplace(m, vrt::vec3(1.0000001f));
+                }
+
+                printf("%f\n", m[3][0]);
+        });
+
+        performance("mat4 * mat4 chain", []{
+                vrt::mat4 step = vrt::translate(vrt::rotate(vrt::mat4(1.0f), 0.01f, vrt::vec3(0, 1, 0)), vrt::vec3(0.001f, 0, 0));
+                vrt::mat4 m(1.0f);
+
+                for (int n = 0; n < 10000000; n++)
+                        m = m * step;
+
+                printf("%f\n", m[3][0]);
+        });
+
+        performance("affine3 * affine3 chain", []{
+                vrt::affine3 step(vrt::translate(vrt::rotate(vrt::mat4(1.0f), 0.01f, vrt::vec3(0, 1, 0)), vrt::vec3(0.001f, 0, 0)));
+                vrt::affine3 m(1.0f);
+
+                for (int n = 0; n < 10000000; n++)
+                        m = m * step;
+
+                printf("%f\n", m[3][0]);
+        });
+
+        performance("translate(rotate(scale(...))) per frame", []{
+                vrt::vec3 t(1, 2, 3), axis(0, 1, 0), s(2, 2, 2);
+                volatile float angle = 30.0f; /* 模拟每帧读取节点数据，阻止编译器把整条链提到循环外 */
+                float r = 0.0f;
+
+                for (int n = 0; n < 10000000; n++)
+                        r += vrt::scale(vrt::rotate(vrt::translate(vrt::mat4(1.0f), t), float(angle), axis), s)[0][0];
+
+                printf("%f\n", r);
+        });
+
+        performance("trs::matrix() cached", []{
+                vrt::trsf32 x(vrt::vec3(1, 2, 3), vrt::angle_axis(30.0f, vrt::vec3(0, 1, 0)), vrt::vec3(2, 2, 2));
+                float r = 0.0f;
+
+                for (int n = 0; n < 10000000; n++)
+                        r += x.matrix()[0][0];
+
+                printf("%f\n", r);
+        });
+
+        static std::vector<vrt::quatf32> qa, qb, qr;
+
+        for (size_t i = 0; i < points.size(); i++) {
+                qa.push_back(vrt::angle_axis(points[i][0] * 360.0f, vrt::vec3(points[i][0], points[i][1], points[i][2])));
+                qb.push_back(vrt::angle_axis(points[i][1] * 360.0f, vrt::vec3(points[i][2], points[i][0], points[i][1])));
+        }
+
+        qr.resize(qa.size());
+
+        performance("slerp(quat) loop", []{
+                for (int n = 0; n < 100; n++)
+                        for (size_t i = 0; i < qa.size(); i++)
+                                qr[i] = vrt::slerp(qa[i], qb[i], n * 0.01f);
+
+                printf("%f\n", qr[0].w);
+        });
+
+        performance("slerp(quat*, quat*) batch", []{
+                for (int n = 0; n < 100; n++)
+                        vrt::slerp(qa.data(), qb.data(), n * 0.01f, qr.data(), qa.size());
+
+                printf("%f\n", qr[0].w);
+        });
+
+        performance("skin_dualquat (4 influences)", []{
+                std::vector<vrt::dualquatf32> bones;
+
+                for (size_t i = 0; i < 64; i++)
+                        bones.push_back(vrt::dualquatf32(qa[i], vrt::vec3(points[i][0], points[i][1], points[i][2])));
+
+                std::vector<vrt::vec4i32> joints(points.size());
+                std::vector<vrt::vec4> weights(points.size(), vrt::vec4(0.4f, 0.3f, 0.2f, 0.1f));
+                std::vector<vrt::vec3> src(points.size()), dst(points.size());
+
+                for (size_t i = 0; i < points.size(); i++) {
+                        joints[i] = vrt::vec4i32(int(i % 64), int((i + 1) % 64), int((i + 7) % 64), int((i + 13) % 64));
+                        src[i] = vrt::vec3(points[i][0], points[i][1], points[i][2]);
+                }
+
+                for (int n = 0; n < 100; n++)
+                        vrt::skin_dualquat(bones.data(), joints.data(), weights.data(), src.data(), dst.data(), src.size());
+
+                printf("%f\n", dst[0].x);
+        });
+
+        performance("cross(vec3) packed", []{
+                std::vector<vrt::vec3> a(points.size()), r(points.size());
+
+                for (size_t i = 0; i < points.size(); i++)
+                        a[i] = vrt::vec3(points[i][0], points[i][1], points[i][2]);
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < a.size(); i++)
+                                r[i] = vrt::cross(a[i], a[(i + n) % a.size()]);
+
+                VRT_PRINT_FORMAT_VECTOR3(r[0]);
+        });
+
+        performance("cross(vec3a) padded", []{
+                std::vector<vrt::vec3a> a(points.size()), r(points.size());
+
+                for (size_t i = 0; i < points.size(); i++)
+                        a[i] = vrt::vec3a(points[i][0], points[i][1], points[i][2]);
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < a.size(); i++)
+                                r[i] = vrt::cross(a[i], a[(i + n) % a.size()]);
+
+                VRT_PRINT_FORMAT_VECTOR3(r[0]);
+        });
+
+        performance("glm inverse(mat4)", []{
+                using namespace glm;
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat4> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = inverse(m[i]);
+
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        performance("vrt inverse(mat4)", []{
+                using namespace vrt;
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat4> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = inverse(m[i]);
+
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        performance("vrt inverse(mat4 const*, mat4*, n)", []{
+                using namespace vrt;
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat4> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 1000; n++)
+                        inverse(m.data(), r.data(), m.size());
+
+                printf("isa: %s\n", isa_name(dispatch_isa()));
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        /* 同样的 SoA 计算使用编译目标宽度的 packet<float>：未指定 -march 时只有 SSE2 的 4 个通道，
+           与上面按指令集选择宽度的批量接口对比 */
+        performance("vrt inverse(mat<4, packet<float>>)", []{
+                using namespace vrt;
+
+                typedef packet<float> P;
+                constexpr size_t W = P::size();
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat4> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i + W <= m.size(); i += W) {
+                                mat<4, P> p;
+
+                                for (int c = 0; c < 4; c++)
+                                        for (int k = 0; k < 4; k++)
+                                                p[c][k] = P([&](auto j) { return m[i + j][c][k]; });
+
+                                P det;
+                                mat<4, P> adj = detail::adjugate(p, det);
+                                P inv = P(1) / det;
+
+                                for (size_t j = 0; j < W; j++)
+                                        for (int c = 0; c < 4; c++)
+                                                for (int k = 0; k < 4; k++)
+                                                        r[i + j][c][k] = adj[c][k][j] * inv[j];
+                        }
+
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        performance("vrt affine_inverse(mat4)", []{
+                using namespace vrt;
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat4> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++) {
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+                        m[i][0].w = m[i][1].w = m[i][2].w = 0;
+                        m[i][3].w = 1;
+                }
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = affine_inverse(m[i]);
+
+                VRT_PRINT_FORMAT_MATRIX4(r[0]);
+        });
+
+        performance("glm transpose(inverse(mat3(mat4)))", []{
+                using namespace glm;
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat3> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = transpose(inverse(mat3(m[i])));
+
+                printf("%f\n", r[0][0][0]);
+        });
+
+        performance("vrt normal_matrix(mat4)", []{
+                using namespace vrt;
+
+                std::vector<mat4> m(matrices.size());
+                std::vector<mat3> r(matrices.size());
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < m.size(); i++)
+                                r[i] = normal_matrix(m[i]);
+
+                printf("%f\n", r[0][0][0]);
+        });
+
+        performance("vrt mat4 palette * vec4", []{
+                using namespace vrt;
+
+                std::vector<mat4> m(matrices.size());
+                vec3 r(0.0f);
+
+                for (size_t i = 0; i < matrices.size(); i++)
+                        memcpy(value_ptr(m[i]), matrices[i].data(), sizeof(mat4));
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++) {
+                                vec4 p = m[(i + n) % m.size()] * vec4(points[i][0], points[i][1], points[i][2], 1.0f);
+                                r += vec3(p.x, p.y, p.z);
+                        }
+
+                VRT_PRINT_FORMAT_VECTOR3(r);
+        });
+
+        performance("vrt mat4x3 palette * vec4", []{
+                using namespace vrt;
+
+                std::vector<mat4x3> m(matrices.size());
+                vec3 r(0.0f);
+
+                for (size_t i = 0; i < matrices.size(); i++) {
+                        mat4 t;
+                        memcpy(value_ptr(t), matrices[i].data(), sizeof(mat4));
+                        m[i] = mat4x3(t);
+                }
+
+                for (int n = 0; n < 1000; n++)
+                        for (size_t i = 0; i < points.size(); i++)
+                                r += m[(i + n) % m.size()] * vec4(points[i][0], points[i][1], points[i][2], 1.0f);
+
+                VRT_PRINT_FORMAT_VECTOR3(r);
+        });
+
+        performance("vrt proj * view * model loop", []{
+                using namespace vrt;
+
+                std::vector<mat4> model(100000);
+                std::vector<mat4> mvp(model.size());
+                mat4 proj, view;
+
+                memcpy(value_ptr(proj), matrices[0].data(), sizeof(mat4));
+                memcpy(value_ptr(view), matrices[1].data(), sizeof(mat4));
+
+                for (size_t i = 0; i < model.size(); i++)
+                        memcpy(value_ptr(model[i]), matrices[i % matrices.size()].data(), sizeof(mat4));
+
+                for (int n = 0; n < 100; n++)
+                        for (size_t i = 0; i < model.size(); i++)
+                                mvp[i] = proj * view * model[i];
+
+                VRT_PRINT_FORMAT_VECTOR4(mvp[model.size() / 2][3]);
+        });
+
+        performance("vrt proj * view * model batch", []{
+                using namespace vrt;
+
+                std::vector<mat4> model(100000);
+                std::vector<mat4> mvp(model.size());
+                mat4 proj, view;
+
+                memcpy(value_ptr(proj), matrices[0].data(), sizeof(mat4));
+                memcpy(value_ptr(view), matrices[1].data(), sizeof(mat4));
+
+                for (size_t i = 0; i < model.size(); i++)
+                        memcpy(value_ptr(model[i]), matrices[i % matrices.size()].data(), sizeof(mat4));
+
+                for (int n = 0; n < 100; n++)
+                        multiply(proj * view, model.data(), mvp.data(), model.size());
+
+                VRT_PRINT_FORMAT_VECTOR4(mvp[model.size() / 2][3]);
+        });
+
+        performance("vrt proj * view * model batch (4 threads)", []{
+                using namespace vrt;
+
+                std::vector<mat4> model(100000);
+                std::vector<mat4> mvp(model.size());
+                std::vector<mat4> ref(model.size());
+                mat4 proj, view;
+
+                memcpy(value_ptr(proj), matrices[0].data(), sizeof(mat4));
+                memcpy(value_ptr(view), matrices[1].data(), sizeof(mat4));
+
+                for (size_t i = 0; i < model.size(); i++)
+                        memcpy(value_ptr(model[i]), matrices[i % matrices.size()].data(), sizeof(mat4));
+
+                multiply(proj * view, model.data(), ref.data(), model.size());
+
+                for (int n = 0; n < 100; n++)
+                        multiply(proj * view, model.data(), mvp.data(), model.size(), 4);
+
+                /* 每段的结果与单线程逐位相同 */
+                printf("%s ", memcmp(ref.data(), mvp.data(), sizeof(mat4) * mvp.size()) == 0 ? "match" : "MISMATCH");
+                VRT_PRINT_FORMAT_VECTOR4(mvp[model.size() / 2][3]);
+        });
 }
 
-#pragma clang diagnostic pop
\ No newline at end of file
+#pragma clang diagnostic pop
@@ -19,15 +19,25 @@
 #define VRT_MAIN_H_
 
 #include "vrt.h"
+#include "expr.h"
+#include "batch.h"
+#include "affine.h"
+#include "quat.h"
+#include "trs.h"
+#include "dualquat.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/fast_square_root.hpp>
 // std
 #include <iostream>
 #include <random>
 #include <tuple>
 #include <array>
 #include <chrono>
+#include <vector>
+#include <cstring>
 
 float rdf32()
 {
@@ -54,4 +64,14 @@ std::array<float, 4> random_float4()
         return { rdf32(), rdf32(), rdf32(), rdf32() };
 }
 
+std::array<float, 16> random_float16()
+{
+        std::array<float, 16> Result;
+
+        for (auto &f : Result)
+                f = rdf32();
+
+        return Result;
+}
+
 #endif /* VRT_MAIN_H_ */
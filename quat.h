@@ -0,0 +1,446 @@
+/* -------------------------------------------------------------------------------- *\
+|*                                                                                  *|
+|*    Copyright (C) 2019-2024 RedGogh All rights reserved.                          *|
+|*                                                                                  *|
+|*    Licensed under the Apache License, Version 2.0 (the "License");               *|
+|*    you may not use this file except in compliance with the License.              *|
+|*    You may obtain a copy of the License at                                       *|
+|*                                                                                  *|
+|*        http://www.apache.org/licenses/LICENSE-2.0                                *|
+|*                                                                                  *|
+|*    Unless required by applicable law or agreed to in writing, software           *|
+|*    distributed under the License is distributed on an "AS IS" BASIS,             *|
+|*    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.      *|
+|*    See the License for the specific language governing permissions and           *|
+|*    limitations under the License.                                                *|
+|*                                                                                  *|
+\* -------------------------------------------------------------------------------- */
+#ifndef VRT_QUAT_H_
+#define VRT_QUAT_H_
+
+#include "vrt.h"
+
+///
+/// 四元数。
+///
+/// 旋转使用单位四元数表示，约定与 rotate() 相同：右手坐标系，角度以度为单位，绕轴逆时针旋转。
+/// 分量按 x, y, z, w 的顺序存储（与 vec4 的通道一致），构造函数的参数顺序与 glm 相同为 (w, x, y, z)。
+///
+///     quatf32 q = angle_axis(90.0f, vec3(0, 0, 1));
+///     vec3 v = rotate(q, vec3(1, 0, 0)); /* (0, 1, 0) */
+///
+namespace vrt
+{
+        ///
+        /// @brief 四元数 w + xi + yj + zk。
+        ///
+        /// @tparam T 浮点数类型
+        /// @tparam Q 存储限定符，非 packed 时按 4 * sizeof(T) 对齐，与 vec4 相同
+        ///
+        template<typename T, qualifier Q = packed>
+        struct alignas(detail::alignment<4, T, Q>::value) quat {
+                // -- Store data define --
+
+                union {
+                        T data[4];
+                        struct { T x, y, z, w; };
+                };
+
+                // -- Constructor --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat() VRT_FUNC_DEFAULT_CTOR;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat(T w, T x, T y, T z);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat(T w, vec<3, T, Q> const& v);
+
+                /* 从旋转矩阵（不含缩放）构造单位四元数，mat4 只使用左上 3x3 */
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit quat(mat<3, T, P> const& m);
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit quat(mat<4, T, P> const& m);
+
+                // -- Conversion --
+
+                /* 单位四元数对应的旋转矩阵 */
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit operator mat<3, T, P>() const;
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit operator mat<4, T, P>() const;
+
+                // -- Operator overrides --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T & operator[](size_t n);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T const& operator[](size_t n) const;
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> xyz() const;
+
+        };
+
+        // -- typedef --
+
+        typedef struct quat<float> quatf32;
+        typedef struct quat<double> quatf64;
+
+        // -- struct quat<T>: Global operator overrides --
+
+        ///
+        /// @brief 四元数乘法 a * b：对应的旋转为先 b 后 a。
+        ///
+        /// 标量分量的四元数整体加载为 4 通道 simd：结果 = a.w * b + a.x * b' + a.y * b'' + a.z * b'''，
+        /// 其中 b'、b''、b''' 为 b 的带符号通道置换，共 4 次向量乘加。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat<T, Q> operator*(quat<T, Q> const& a, quat<T, Q> const& b);
+
+        ///
+        /// @brief 使用单位四元数旋转向量，同 rotate(q, v)。
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> operator*(quat<T, Q> const& q, vec<3, T, P> const& v);
+
+        // -- Functions --
+
+        ///
+        /// @brief 创建绕轴 `axis` 逆时针旋转 `angle` 度的单位四元数。
+        ///
+        /// @param angle 旋转角度（度）
+        /// @param axis 旋转轴（不需要是单位向量，但不能为零向量）
+        /// @return quat<T> 返回单位四元数，mat4(angle_axis(a, v)) 与 rotate(mat4(1), a, v) 相同
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat<T, Q> angle_axis(T angle, vec<3, T, Q> const& axis);
+
+        ///
+        /// @brief 使用单位四元数旋转向量。
+        ///
+        /// 使用两次叉积的形式：t = 2 * cross(q.xyz, v)，v' = v + w * t + cross(q.xyz, t)，
+        /// 共 15 次乘法，不构造旋转矩阵。
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> rotate(quat<T, Q> const& q, vec<3, T, P> const& v);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T dot(quat<T, Q> const& a, quat<T, Q> const& b);
+
+        ///
+        /// @brief 共轭四元数 (w, -x, -y, -z)，对单位四元数即为逆旋转。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat<T, Q> conjugate(quat<T, Q> const& q);
+
+        ///
+        /// @brief 逆四元数 conjugate(q) / dot(q, q)，q 不能为零四元数。
+        ///
+        /// @note 单位四元数直接使用 conjugate()，省去一次除法。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat<T, Q> inverse(quat<T, Q> const& q);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat<T, Q> normalize(quat<T, Q> const& q);
+
+        ///
+        /// @brief 归一化线性插值：normalize(a + (b - a) * t)，取最短路径。
+        ///
+        /// 角速度不均匀，但比 slerp() 少一次 acos 与两次 sin，适合相邻帧之间的小角度混合。
+        /// 分量可以是 packet（quat<packet<float>>），一次插值多组四元数。
+        ///
+        /// @param a 起始单位四元数
+        /// @param b 结束单位四元数
+        /// @param t 插值系数，[0, 1]
+        /// @return quat<T> 返回单位四元数
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat<T, Q> nlerp(quat<T, Q> const& a, quat<T, Q> const& b, T t);
+
+        ///
+        /// @brief 球面线性插值，取最短路径，角速度均匀。
+        ///
+        /// 两个四元数夹角很小时 sin 趋近于 0，此时退化为 nlerp()。退化使用掩码混合而非分支，
+        /// 分量可以是 packet，各通道独立选择。
+        ///
+        /// @see nlerp()
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat<T, Q> slerp(quat<T, Q> const& a, quat<T, Q> const& b, T t);
+
+        // -- detail --
+
+        namespace detail
+        {
+                /* 标量分量的四元数按 4 通道 simd 加载与存储 */
+                template<typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_INLINE simd_t<4, T, Q> load(quat<T, Q> const& q);
+
+                template<typename T, qualifier Q, typename Abi>
+                VRT_FUNC_DECL VRT_INLINE void store(std::experimental::simd<T, Abi> data, quat<T, Q>& q);
+        }
+
+        // -- struct quat<T>: implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q>::quat(T w, T x, T y, T z)
+        {
+                this->x = x;
+                this->y = y;
+                this->z = z;
+                this->w = w;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q>::quat(T w, vec<3, T, Q> const& v)
+                : quat(w, v.x, v.y, v.z)
+        {}
+
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR quat<T, Q>::quat(mat<3, T, P> const& m)
+        {
+                /* Shepperd 方法：选取迹与三个对角元素中最大者开方，避免小数相除 */
+                T m00 = m[0].x, m11 = m[1].y, m22 = m[2].z;
+                T tr = m00 + m11 + m22;
+
+                if (tr > 0) {
+                        T s = sqrt(tr + 1) * 2;
+                        w = s / 4;
+                        x = (m[1].z - m[2].y) / s;
+                        y = (m[2].x - m[0].z) / s;
+                        z = (m[0].y - m[1].x) / s;
+                } else if (m00 > m11 && m00 > m22) {
+                        T s = sqrt(1 + m00 - m11 - m22) * 2;
+                        w = (m[1].z - m[2].y) / s;
+                        x = s / 4;
+                        y = (m[1].x + m[0].y) / s;
+                        z = (m[2].x + m[0].z) / s;
+                } else if (m11 > m22) {
+                        T s = sqrt(1 + m11 - m00 - m22) * 2;
+                        w = (m[2].x - m[0].z) / s;
+                        x = (m[1].x + m[0].y) / s;
+                        y = s / 4;
+                        z = (m[2].y + m[1].z) / s;
+                } else {
+                        T s = sqrt(1 + m22 - m00 - m11) * 2;
+                        w = (m[0].y - m[1].x) / s;
+                        x = (m[2].x + m[0].z) / s;
+                        y = (m[2].y + m[1].z) / s;
+                        z = s / 4;
+                }
+        }
+
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR quat<T, Q>::quat(mat<4, T, P> const& m)
+                : quat(mat<3, T, P>(m[0].x, m[0].y, m[0].z,
+                                    m[1].x, m[1].y, m[1].z,
+                                    m[2].x, m[2].y, m[2].z))
+        {}
+
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR quat<T, Q>::operator mat<3, T, P>() const
+        {
+                T xx = x * x, yy = y * y, zz = z * z;
+                T xy = x * y, xz = x * z, yz = y * z;
+                T wx = w * x, wy = w * y, wz = w * z;
+
+                return mat<3, T, P>(
+                        1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy),
+                        2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx),
+                        2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy));
+        }
+
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR quat<T, Q>::operator mat<4, T, P>() const
+        {
+                T xx = x * x, yy = y * y, zz = z * z;
+                T xy = x * y, xz = x * z, yz = y * z;
+                T wx = w * x, wy = w * y, wz = w * z;
+
+                return mat<4, T, P>(
+                        1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy), 0,
+                        2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx), 0,
+                        2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy), 0,
+                        0, 0, 0, 1);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T& quat<T, Q>::operator[](size_t n)
+        {
+                VRT_CHECK_INDEX(n, 4);
+
+                if consteval {
+                        /* 常量求值只能访问联合体的活动成员（x, y, z, w） */
+                        return n == 0 ? x : (n == 1 ? y : (n == 2 ? z : w));
+                } else {
+                        return data[n];
+                }
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T const& quat<T, Q>::operator[](size_t n) const
+        {
+                VRT_CHECK_INDEX(n, 4);
+
+                if consteval {
+                        /* 常量求值只能访问联合体的活动成员（x, y, z, w） */
+                        return n == 0 ? x : (n == 1 ? y : (n == 2 ? z : w));
+                } else {
+                        return data[n];
+                }
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> quat<T, Q>::xyz() const
+        {
+                return vec<3, T, Q>(x, y, z);
+        }
+
+        // -- struct quat<T>: Global operator implements --
+
+        namespace detail
+        {
+                template<typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_INLINE simd_t<4, T, Q> load(quat<T, Q> const& q)
+                {
+                        using namespace std::experimental;
+
+                        if constexpr (Q == packed)
+                                return simd_t<4, T, Q>(q.data, element_aligned);
+                        else
+                                return simd_t<4, T, Q>(q.data, overaligned<alignment<4, T, Q>::value>);
+                }
+
+                template<typename T, qualifier Q, typename Abi>
+                VRT_FUNC_DECL VRT_INLINE void store(std::experimental::simd<T, Abi> data, quat<T, Q>& q)
+                {
+                        using namespace std::experimental;
+
+                        if constexpr (Q == packed)
+                                data.copy_to(q.data, element_aligned);
+                        else
+                                data.copy_to(q.data, overaligned<alignment<4, T, Q>::value>);
+                }
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q> operator*(quat<T, Q> const& a, quat<T, Q> const& b)
+        {
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                typedef detail::simd_t<4, T, Q> S;
+
+                                /* 通道顺序 x, y, z, w：
+                                     x = aw bx + ax bw + ay bz - az by
+                                     y = aw by - ax bz + ay bw + az bx
+                                     z = aw bz + ax by - ay bx + az bw
+                                     w = aw bw - ax bx - ay by - az bz */
+                                S b0 = detail::load(b);
+                                S b1([&](auto i) { constexpr int I[] = { 3, 2, 1, 0 }; constexpr T F[] = { 1, -1, 1, -1 }; return b.data[I[i]] * F[i]; });
+                                S b2([&](auto i) { constexpr int I[] = { 2, 3, 0, 1 }; constexpr T F[] = { 1, 1, -1, -1 }; return b.data[I[i]] * F[i]; });
+                                S b3([&](auto i) { constexpr int I[] = { 1, 0, 3, 2 }; constexpr T F[] = { -1, 1, 1, -1 }; return b.data[I[i]] * F[i]; });
+
+                                quat<T, Q> Result;
+                                detail::store(a.w * b0 + a.x * b1 + a.y * b2 + a.z * b3, Result);
+
+                                return Result;
+                        }
+                }
+
+                return quat<T, Q>(a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                                  a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                                  a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                                  a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> operator*(quat<T, Q> const& q, vec<3, T, P> const& v)
+        {
+                return rotate(q, v);
+        }
+
+        // -- Functions implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q> angle_axis(T angle, vec<3, T, Q> const& axis)
+        {
+                T s, c;
+                vrt::sincos(angle * T(M_PI / 360), s, c); /* 半角 */
+
+                return quat<T, Q>(c, normalize(axis) * s);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> rotate(quat<T, Q> const& q, vec<3, T, P> const& v)
+        {
+                vec<3, T, P> u(q.x, q.y, q.z);
+                vec<3, T, P> t = cross(u, v) * T(2);
+
+                return v + t * q.w + cross(u, t);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T dot(quat<T, Q> const& a, quat<T, Q> const& b)
+        {
+                return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q> conjugate(quat<T, Q> const& q)
+        {
+                return quat<T, Q>(q.w, -q.x, -q.y, -q.z);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q> inverse(quat<T, Q> const& q)
+        {
+                T inv = T(1) / dot(q, q);
+
+                return quat<T, Q>(q.w * inv, -q.x * inv, -q.y * inv, -q.z * inv);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q> normalize(quat<T, Q> const& q)
+        {
+                T inv = T(1) / sqrt(dot(q, q));
+
+                return quat<T, Q>(q.w * inv, q.x * inv, q.y * inv, q.z * inv);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q> nlerp(quat<T, Q> const& a, quat<T, Q> const& b, T t)
+        {
+                /* q 与 -q 表示同一旋转，夹角为钝角时翻转 b 以取最短路径 */
+                T u = detail::select(dot(a, b) < T(0), -t, t);
+                T v = T(1) - t;
+
+                return normalize(quat<T, Q>(a.w * v + b.w * u, a.x * v + b.x * u, a.y * v + b.y * u, a.z * v + b.z * u));
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q> slerp(quat<T, Q> const& a, quat<T, Q> const& b, T t)
+        {
+                typedef detail::scalar_t<T> U;
+
+                T d = dot(a, b);
+                T sign = detail::select(d < T(0), T(-1), T(1));
+
+                d *= sign;
+
+                /* 夹角很小时 1 / sin(theta) 失去精度，改用归一化的线性插值 */
+                auto near = d > T(U(1) - std::numeric_limits<U>::epsilon() * 8);
+
+                T theta = arccos(detail::select(near, T(0), d));
+                T inv = T(1) / vrt::sin(detail::select(near, T(1), theta));
+                T u = detail::select(near, t, vrt::sin(t * theta) * inv) * sign;
+                T v = detail::select(near, T(1) - t, vrt::sin((T(1) - t) * theta) * inv);
+
+                quat<T, Q> Result(a.w * v + b.w * u, a.x * v + b.x * u, a.y * v + b.y * u, a.z * v + b.z * u);
+
+                /* 只有退化通道需要归一化，其余通道缩放系数为 1 */
+                T s = detail::select(near, T(1) / sqrt(dot(Result, Result)), T(1));
+
+                return quat<T, Q>(Result.w * s, Result.x * s, Result.y * s, Result.z * s);
+        }
+}
+
+#endif /* VRT_QUAT_H_ */
@@ -0,0 +1,279 @@
+/* -------------------------------------------------------------------------------- *\
+|*                                                                                  *|
+|*    Copyright (C) 2019-2024 RedGogh All rights reserved.                          *|
+|*                                                                                  *|
+|*    Licensed under the Apache License, Version 2.0 (the "License");               *|
+|*    you may not use this file except in compliance with the License.              *|
+|*    You may obtain a copy of the License at                                       *|
+|*                                                                                  *|
+|*        http://www.apache.org/licenses/LICENSE-2.0                                *|
+|*                                                                                  *|
+|*    Unless required by applicable law or agreed to in writing, software           *|
+|*    distributed under the License is distributed on an "AS IS" BASIS,             *|
+|*    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.      *|
+|*    See the License for the specific language governing permissions and           *|
+|*    limitations under the License.                                                *|
+|*                                                                                  *|
+\* -------------------------------------------------------------------------------- */
+#ifndef VRT_TRS_H_
+#define VRT_TRS_H_
+
+#include "affine.h"
+#include "quat.h"
+// std
+#include <bit>
+#include <cstdint>
+#include <atomic>
+
+///
+/// 分解形式的变换：平移（T）、旋转（R，单位四元数）、缩放（S），矩阵为 T * R * S。
+///
+/// 场景节点保存 trs 而不是每帧调用 translate(rotate(scale(...)))：矩阵在第一次读取时才合成并缓存，
+/// 只有通过 set_*() 修改分量后才重新计算。每次构造或修改都从全局计数器取一个新的 version()，
+/// 不同对象、不同状态的版本号互不相同（赋值时随内容一起复制；constexpr 构造的对象使用置最高位的内容散列，
+/// 与运行期的计数器不相交），父子节点可以据此判断缓存的世界矩阵是否过期：
+///
+///     if (node.local.version() != node.seen) { world = parent_world * node.local.matrix(); node.seen = node.local.version(); }
+///
+namespace vrt
+{
+        ///
+        /// @brief 平移、旋转、缩放分解形式的变换，带延迟合成的矩阵缓存。
+        ///
+        /// @tparam T 浮点数类型
+        /// @tparam Q 存储限定符
+        ///
+        template<typename T, qualifier Q = packed>
+        struct trs {
+                // -- Constructor --
+
+                /* 单位变换 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR trs();
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR trs(vec<3, T, Q> const& t, quat<T, Q> const& r, vec<3, T, Q> const& s);
+
+                // -- Access --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> const& translation() const;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR quat<T, Q> const& rotation() const;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> const& scale() const;
+
+                /* 修改分量，使缓存的矩阵失效并递增版本号 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void set_translation(vec<3, T, Q> const& t);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void set_rotation(quat<T, Q> const& r);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void set_scale(vec<3, T, Q> const& s);
+
+                /* 构造及每次 set_*() 时从全局计数器取新值（从 1 开始，常量求值时为置最高位的内容散列），用于判断依赖此变换的缓存是否过期 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR uint32_t version() const;
+
+                // -- Matrix --
+
+                ///
+                /// @brief 返回 T * R * S 的仿射矩阵，首次调用或修改分量后合成一次，之后直接返回缓存。
+                ///
+                /// 合成直接写出矩阵元素：旋转矩阵的每一列乘以对应的缩放，平移放入最后一列，不做矩阵乘法。
+                ///
+                /// @note 虽然是 const 成员，首次调用会写入缓存且没有同步：多个线程共享同一个 trs 时，
+                ///       应在共享前调用一次 matrix()，或由调用者加锁。
+                ///
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR affine<T, Q> const& matrix() const;
+
+                /* matrix() 扩展为 4x4 矩阵 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> matrix4() const;
+
+        private:
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void touch();
+
+                vec<3, T, Q> t_;
+                quat<T, Q> r_;
+                vec<3, T, Q> s_;
+
+                uint32_t version_ = 0;
+
+                mutable affine<T, Q> matrix_{};
+                mutable bool dirty_ = true;
+        };
+
+        // -- typedef --
+
+        typedef struct trs<float> trsf32;
+        typedef struct trs<double> trsf64;
+
+        // -- struct trs<T>: Global operator overrides --
+
+        ///
+        /// @brief 复合两个变换 a * b（先 b 后 a），不经过矩阵：
+        ///
+        ///   t = a.t + a.r * (a.s * b.t)，r = a.r * b.r，s = a.s * b.s
+        ///
+        /// @note a 的缩放为均匀缩放（或 b 没有旋转）时结果精确；否则 a.s 与 b.r 组合出的切变
+        ///       无法用 TRS 表示，结果的缩放是沿 b 的局部轴的近似值（与常见引擎的 lossy scale 相同）。
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR trs<T, Q> operator*(trs<T, Q> const& a, trs<T, Q> const& b);
+
+        // -- Functions --
+
+        ///
+        /// @brief 逐分量插值两个变换：平移与缩放线性插值，旋转使用 slerp()。
+        ///
+        /// @param a 起始变换
+        /// @param b 结束变换
+        /// @param t 插值系数，[0, 1]
+        /// @return trs<T> 返回插值后的变换
+        ///
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR trs<T, Q> mix(trs<T, Q> const& a, trs<T, Q> const& b, T t);
+
+        ///
+        /// @brief 变换一个点：t + r * (s * p)，不合成矩阵。
+        ///
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> transform_point(trs<T, Q> const& x, vec<3, T, P> const& p);
+
+        // -- detail --
+
+        namespace detail
+        {
+                /* 所有 trs 共享的版本计数器，只要求唯一，不用于同步；运行期版本号在 [1, 2^31)，常量求值的版本号置最高位 */
+                inline std::atomic<uint32_t> trs_version { 0 };
+                inline constexpr uint32_t trs_version_consteval = 0x80000000u;
+        }
+
+        // -- struct trs<T>: implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR trs<T, Q>::trs()
+                : trs(vec<3, T, Q>(0, 0, 0), quat<T, Q>(1, 0, 0, 0), vec<3, T, Q>(1, 1, 1))
+        {}
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR trs<T, Q>::trs(vec<3, T, Q> const& t, quat<T, Q> const& r, vec<3, T, Q> const& s)
+                : t_(t), r_(r), s_(s)
+        {
+                touch();
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> const& trs<T, Q>::translation() const
+        {
+                return t_;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR quat<T, Q> const& trs<T, Q>::rotation() const
+        {
+                return r_;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> const& trs<T, Q>::scale() const
+        {
+                return s_;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR void trs<T, Q>::set_translation(vec<3, T, Q> const& t)
+        {
+                t_ = t;
+                touch();
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR void trs<T, Q>::set_rotation(quat<T, Q> const& r)
+        {
+                r_ = r;
+                touch();
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR void trs<T, Q>::set_scale(vec<3, T, Q> const& s)
+        {
+                s_ = s;
+                touch();
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR void trs<T, Q>::touch()
+        {
+                dirty_ = true;
+
+                /* 常量求值时无法访问全局计数器：取分量位模式的 FNV-1a 散列并置最高位，与运行期版本号不相交；
+                   不同的常量对象只有内容相同才会得到相同版本号，此时缓存的矩阵也相同 */
+                if consteval {
+                        uint32_t h = 2166136261u;
+                        for (T v : { t_.x, t_.y, t_.z, r_.x, r_.y, r_.z, r_.w, s_.x, s_.y, s_.z }) {
+                                uint64_t bits = sizeof(T) == 4 ? std::bit_cast<uint32_t>(float(v)) : std::bit_cast<uint64_t>(double(v));
+                                h = (h ^ uint32_t(bits)) * 16777619u;
+                                h = (h ^ uint32_t(bits >> 32)) * 16777619u;
+                        }
+                        version_ = h | detail::trs_version_consteval;
+                } else {
+                        version_ = detail::trs_version.fetch_add(1, std::memory_order_relaxed) % (detail::trs_version_consteval - 1) + 1;
+                }
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR uint32_t trs<T, Q>::version() const
+        {
+                return version_;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR affine<T, Q> const& trs<T, Q>::matrix() const
+        {
+                if (!dirty_)
+                        return matrix_;
+
+                quat<T, Q> const& q = r_;
+
+                T xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+                T xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+                T wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+                matrix_[0] = vec<3, T, Q>(1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy)) * s_.x;
+                matrix_[1] = vec<3, T, Q>(2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx)) * s_.y;
+                matrix_[2] = vec<3, T, Q>(2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy)) * s_.z;
+                matrix_[3] = t_;
+
+                dirty_ = false;
+
+                return matrix_;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> trs<T, Q>::matrix4() const
+        {
+                return mat<4, T, Q>(matrix());
+        }
+
+        // -- struct trs<T>: Global operator implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR trs<T, Q> operator*(trs<T, Q> const& a, trs<T, Q> const& b)
+        {
+                return trs<T, Q>(a.translation() + rotate(a.rotation(), a.scale() * b.translation()),
+                                 a.rotation() * b.rotation(),
+                                 a.scale() * b.scale());
+        }
+
+        // -- Functions implements --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR trs<T, Q> mix(trs<T, Q> const& a, trs<T, Q> const& b, T t)
+        {
+                return trs<T, Q>(a.translation() + (b.translation() - a.translation()) * t,
+                                 slerp(a.rotation(), b.rotation(), t),
+                                 a.scale() + (b.scale() - a.scale()) * t);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> transform_point(trs<T, Q> const& x, vec<3, T, P> const& p)
+        {
+                vec<3, T, P> s(x.scale().x * p.x, x.scale().y * p.y, x.scale().z * p.z);
+                vec<3, T, P> t(x.translation().x, x.translation().y, x.translation().z);
+
+                return t + rotate(x.rotation(), s);
+        }
+}
+
+#endif /* VRT_TRS_H_ */
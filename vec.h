@@ -19,26 +19,84 @@
 #define VRT_VEC_H_
 
 #include <experimental/simd>
+// std
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #define VRT_FUNC_DECL          /* UNDEF */
 #define VRT_INLINE             inline
 #define VRT_FUNC_CONSTEXPR     constexpr
 #define VRT_FUNC_DEFAULT_CTOR  = default
 
+/* simd 加载 / 写回等必须展开的小函数：留在函数外时 simd 会经过栈传递，GCC 对 inline 的启发式不保证展开 */
+#if defined(__GNUC__)
+#  define VRT_FORCE_INLINE     inline __attribute__((always_inline))
+#else
+#  define VRT_FORCE_INLINE     inline
+#endif
+
+/* 下标越界检查：默认仅在调试构建（未定义 NDEBUG）时开启，也可以手动定义 VRT_BOUNDS_CHECK 为 0/1 */
+#ifndef VRT_BOUNDS_CHECK
+#  ifdef NDEBUG
+#    define VRT_BOUNDS_CHECK 0
+#  else
+#    define VRT_BOUNDS_CHECK 1
+#  endif
+#endif
+
+#if VRT_BOUNDS_CHECK
+#  define VRT_CHECK_INDEX(n, N)                                                                 \
+        do {                                                                                    \
+            if ((n) >= (N))                                                                     \
+                throw std::runtime_error("out of index");                                      \
+        } while(0)
+#else
+#  define VRT_CHECK_INDEX(n, N) ((void) 0)
+#endif
+
 namespace vrt
 {
+        // -- Qualifier --
+
+        ///
+        /// @brief 向量与矩阵的存储布局限定符（参考 glm 的 qualifier）。
+        ///
+        ///  - packed：紧凑存储，sizeof(vec<N, T>) == N * sizeof(T)，适合文件读写与顶点缓冲。
+        ///  - padded：填充存储，vec3 补齐第 4 个分量（恒为 0）并按 4 * sizeof(T) 对齐，
+        ///            SIMD 内核可以安全地整宽对齐加载/存储而不会越界读取。
+        ///  - aligned16：按 16 字节（且不小于 padded）对齐，vec3 同样补齐第 4 个分量。
+        ///  - aligned32：按 32 字节对齐，适用于 AVX 加载，vec3 同样补齐第 4 个分量。
+        ///
+        /// 矩阵的每一列使用相同限定符的向量存储，因此矩阵的对齐与其列一致。
+        ///
+        enum qualifier {
+                packed,
+                padded,
+                aligned16,
+                aligned32
+        };
+
         // -- Vector & Matrix --
         
-        template<size_t N, typename T> struct vec;
-        template<size_t N, typename T> struct mat;
+        template<size_t N, typename T, qualifier Q = packed> struct vec;
+        template<size_t N, typename T, qualifier Q = packed> struct mat;
+
+        template<typename T, qualifier Q> struct vec<2, T, Q>;
+        template<typename T, qualifier Q> struct vec<3, T, Q>;
+        template<typename T, qualifier Q> struct vec<4, T, Q>;
 
-        template<typename T> struct vec<2, T>;
-        template<typename T> struct vec<3, T>;
-        template<typename T> struct vec<4, T>;
+        template<typename T, qualifier Q> struct mat<2, T, Q>;
+        template<typename T, qualifier Q> struct mat<3, T, Q>;
+        template<typename T, qualifier Q> struct mat<4, T, Q>;
 
-        template<typename T> struct mat<2, T>;
-        template<typename T> struct mat<3, T>;
-        template<typename T> struct mat<4, T>;
+        /* C 列 R 行的非方阵，方阵使用 mat<N, T> */
+        template<size_t C, size_t R, typename T, qualifier Q = packed> struct matrix;
 
         // -- typedef --
 
@@ -62,6 +120,22 @@ namespace vrt
         typedef struct vec<3, float> vec3;
         typedef struct vec<4, float> vec4;
 
+        typedef struct vec<3, float, padded> vec3af32;
+        typedef struct vec<3, double, padded> vec3af64;
+        typedef struct vec<3, float, padded> vec3a;
+
+        typedef struct vec<4, float, aligned16> vec4af32;
+        typedef struct vec<4, double, aligned32> vec4af64;
+        typedef struct vec<4, float, aligned16> vec4a;
+
+        typedef struct vec<8, float> vec8f32;
+        typedef struct vec<16, float> vec16f32;
+        typedef struct vec<8, double> vec8f64;
+        typedef struct vec<16, double> vec16f64;
+
+        typedef struct vec<8, float> vec8;
+        typedef struct vec<16, float> vec16;
+
         typedef struct mat<2, int> mat2i32;
         typedef struct mat<3, int> mat3i32;
         typedef struct mat<4, int> mat4i32;
@@ -82,13 +156,162 @@ namespace vrt
         typedef struct mat<3, float> mat3;
         typedef struct mat<4, float> mat4;
 
+        typedef struct mat<3, float, aligned16> mat3af32;
+        typedef struct mat<3, double, aligned32> mat3af64;
+        typedef struct mat<3, float, aligned16> mat3a;
+
+        typedef struct mat<4, float, aligned16> mat4af32;
+        typedef struct mat<4, double, aligned32> mat4af64;
+        typedef struct mat<4, float, aligned16> mat4a;
+
+        /* matCxR：C 列 R 行（与 glm 相同），例如 mat4x3 为 4 列 vec3 的三维仿射变换 */
+        typedef struct matrix<2, 3, float> mat2x3f32;
+        typedef struct matrix<2, 4, float> mat2x4f32;
+        typedef struct matrix<3, 2, float> mat3x2f32;
+        typedef struct matrix<3, 4, float> mat3x4f32;
+        typedef struct matrix<4, 2, float> mat4x2f32;
+        typedef struct matrix<4, 3, float> mat4x3f32;
+
+        typedef struct matrix<2, 3, double> mat2x3f64;
+        typedef struct matrix<2, 4, double> mat2x4f64;
+        typedef struct matrix<3, 2, double> mat3x2f64;
+        typedef struct matrix<3, 4, double> mat3x4f64;
+        typedef struct matrix<4, 2, double> mat4x2f64;
+        typedef struct matrix<4, 3, double> mat4x3f64;
+
+        typedef struct matrix<2, 3, float> mat2x3;
+        typedef struct matrix<2, 4, float> mat2x4;
+        typedef struct matrix<3, 2, float> mat3x2;
+        typedef struct matrix<3, 4, float> mat3x4;
+        typedef struct matrix<4, 2, float> mat4x2;
+        typedef struct matrix<4, 3, float> mat4x3;
+
+        // -- Packet --
+
+        ///
+        /// @brief SoA 数据包：一个 simd 寄存器保存 W 个不同向量的同一分量。
+        ///
+        /// 以 packet 作为分量类型实例化 vec / mat（例如 vec<3, packet<float, 8>>），
+        /// x、y、z 各占一个寄存器，每条指令同时处理 W 个向量；dot、length、normalize、cross
+        /// 以及矩阵乘法等接口保持不变，模板代码无需改写即可批量运行。
+        ///
+        /// @tparam T 标量类型
+        /// @tparam W 每个数据包的向量个数，默认为当前目标的原生 simd 宽度
+        ///
+        /// @note 数据包使用原生 ABI（simd_abi::deduce_t），W 不能超过编译目标的寄存器宽度
+        ///       （SSE 为 4 个 float，AVX 为 8 个，AVX-512 为 16 个）：跨多个寄存器的 fixed_size
+        ///       simd 不可平凡复制，无法作为 vec 联合体的成员。
+        ///
+        template<typename T, size_t W = std::experimental::simd_size_v<T, std::experimental::simd_abi::native<T>>>
+        using packet = std::experimental::simd<T, std::experimental::simd_abi::deduce_t<T, W>>;
+
+        template<size_t W, typename T = float> using vec2_packet = vec<2, packet<T, W>>;
+        template<size_t W, typename T = float> using vec3_packet = vec<3, packet<T, W>>;
+        template<size_t W, typename T = float> using vec4_packet = vec<4, packet<T, W>>;
+        template<size_t W, typename T = float> using mat3_packet = mat<3, packet<T, W>>;
+        template<size_t W, typename T = float> using mat4_packet = mat<4, packet<T, W>>;
+
+        // -- detail --
+
+        namespace detail
+        {
+                /* 存储通道数：非 packed 的 vec3 补齐为 4 个通道 */
+                template<size_t N, qualifier Q>
+                struct lanes { static constexpr size_t value = (N == 3 && Q != packed) ? 4 : N; };
+
+                /* 存储对齐：packed 与 N > 4 的宽向量保持元素对齐，其余至少按全部通道宽度对齐 */
+                template<size_t N, typename T, qualifier Q>
+                struct alignment {
+                        static constexpr size_t natural = Q == packed || N > 4 ? alignof(T) : lanes<N, Q>::value * sizeof(T);
+                        static constexpr size_t request = Q == aligned32 ? 32 : (Q == aligned16 ? 16 : 0);
+                        static constexpr size_t value = natural > request ? natural : request;
+                };
+
+                /* 分量本身是 simd（SoA 数据包） */
+                template<typename T>
+                struct is_packet : std::false_type {};
+
+                template<typename T, typename Abi>
+                struct is_packet<std::experimental::simd<T, Abi>> : std::true_type {};
+
+                template<typename T>
+                inline constexpr bool is_packet_v = is_packet<T>::value;
+
+                /* 内核使用的寄存器类型：标量分量加载为 simd，数据包分量本身已在寄存器中，直接使用 vec */
+                template<size_t N, typename T, qualifier Q, bool = is_packet_v<T>>
+                struct simd_type { typedef std::experimental::simd<T, std::experimental::simd_abi::fixed_size<lanes<N, Q>::value>> type; };
+
+                template<size_t N, typename T, qualifier Q>
+                struct simd_type<N, T, Q, true> { typedef vec<N, T, Q> type; };
+
+                template<size_t N, typename T, qualifier Q>
+                using simd_t = typename simd_type<N, T, Q>::type;
+
+                template<size_t N, typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_FORCE_INLINE simd_t<N, T, Q> load(vec<N, T, Q> const& v);
+
+                template<size_t N, typename T, qualifier Q, typename Abi>
+                VRT_FUNC_DECL VRT_FORCE_INLINE void store(std::experimental::simd<T, Abi> data, vec<N, T, Q>& v);
+
+                template<size_t N, typename T, qualifier Q, qualifier P>
+                requires is_packet_v<T>
+                VRT_FUNC_DECL VRT_FORCE_INLINE void store(vec<N, T, P> const& data, vec<N, T, Q>& v);
+
+                /* C 列 R 行矩阵的类型：方阵为 mat<N, T>，其余为 matrix<C, R, T> */
+                template<size_t C, size_t R, typename T, qualifier Q, bool = (C == R)>
+                struct mat_type { typedef matrix<C, R, T, Q> type; };
+
+                template<size_t C, size_t R, typename T, qualifier Q>
+                struct mat_type<C, R, T, Q, true> { typedef mat<C, T, Q> type; };
+
+                template<size_t C, size_t R, typename T, qualifier Q>
+                using mat_t = typename mat_type<C, R, T, Q>::type;
+
+                /*
+                 * 矩阵列的寄存器形式：
+                 *   列占满 4 个通道或为数据包时直接 load()；
+                 *   packed vec3 的列在矩阵中连续存放，以 4 通道重叠读取（fixed_size<3> 的 simd 载入很慢）；
+                 *   vec2 的列逐分量计算，由编译器向量化。
+                 */
+                enum class column_kind { simd, overlap, scalar };
+
+                template<size_t R, typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR column_kind column_kind_of()
+                {
+                        if (lanes<R, Q>::value == 4 || is_packet_v<T>)
+                                return column_kind::simd;
+
+                        return R == 3 ? column_kind::overlap : column_kind::scalar;
+                }
+
+                template<size_t R, typename T, qualifier Q>
+                using column_t = std::conditional_t<column_kind_of<R, T, Q>() == column_kind::overlap, simd_t<4, T, packed>, simd_t<R, T, Q>>;
+
+                /* 载入 C 列矩阵 a 的第 k 列：重叠读取时多出的第 4 个通道属于下一列，最后一列向前多读一个再移位 */
+                template<size_t C, size_t R, typename T, qualifier Q, typename A>
+                VRT_FUNC_DECL VRT_INLINE column_t<R, T, Q> load_column(A const& a, size_t k);
+
+                /* Result[j] = Σ a[k] * b[j][k]：a 的 C 列常驻寄存器，按列广播乘加，a、b 可以是方阵或非方阵 */
+                template<size_t C, size_t K, size_t R, typename T, qualifier Q, typename A, typename B, typename M>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void mul_columns(A const& a, B const& b, M& Result);
+
+                /* Result = Σ m[k] * v[k] */
+                template<size_t C, size_t R, typename T, qualifier Q, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<R, T, P> mul_vector(matrix<C, R, T, Q> const& m, vec<C, T, P> const& v);
+
+                /* 以 f(i) 为第 i 个分量构造 vec<N, T>（常量求值时只能整体构造联合体） */
+                template<size_t N, typename T, qualifier Q, typename F>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> make_vec(F const& f);
+        }
+
         // -- struct vec<2, T> --
 
-        template<typename T>
-        struct vec<2, T> {
+        template<typename T, qualifier Q>
+        struct alignas(detail::alignment<2, T, Q>::value) vec<2, T, Q> {
                 // -- Store data define --
 
                 union {
+                        T data[2];
                         struct { T x, y; };
                         struct { T r, g; };
                 };
@@ -96,160 +319,168 @@ namespace vrt
                 // -- Constructor for vec2 --
 
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec() VRT_FUNC_DEFAULT_CTOR;
-                VRT_FUNC_DECL explicit vec(T s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit vec(T s);
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<2, T, P> const& v);
                 VRT_FUNC_DECL VRT_INLINE VRT_FUNC_CONSTEXPR vec(T x, T y);
 
                 // -- Operator override --
                 
-                template<typename U>
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator=(vec<2, U> const& v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator=(vec<2, T> const& v) VRT_FUNC_DEFAULT_CTOR;
+                template<typename U, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator=(vec<2, U, P> const& v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator=(vec<2, T, Q> const& v) VRT_FUNC_DEFAULT_CTOR;
 
-                template<typename U>
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator=(vec<3, U> const& v);
+                template<typename U, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator=(vec<3, U, P> const& v);
                 
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T & operator[](size_t n);
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T const& operator[](size_t n) const;
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator+=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator-=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator*=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator/=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator+=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator-=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator*=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator/=(T const &s);
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator+=(vec<2, T> const &v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator-=(vec<2, T> const &v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator*=(vec<2, T> const &v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator/=(vec<2, T> const &v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator+=(vec<2, T, Q> const &v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator-=(vec<2, T, Q> const &v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator*=(vec<2, T, Q> const &v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator/=(vec<2, T, Q> const &v);
 
         };
 
         // -- struct vec<2, T>: Global operator overrides --
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator+(vec<2, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator-(vec<2, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator*(vec<2, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator/(vec<2, T> const& v, T const &s);
-
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator+(vec<2, T> const& v1, vec<2, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator-(vec<2, T> const& v1, vec<2, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator*(vec<2, T> const& v1, vec<2, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator/(vec<2, T> const& v1, vec<2, T> const &v2);
-
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator+(vec<2, T> const& v1, U const& u);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator-(vec<2, T> const& v1, U const& u);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator*(vec<2, T> const& v1, U const& u);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator/(vec<2, T> const& v1, U const& u);
-
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator+(U const& u, vec<2, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator-(U const& u, vec<2, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator*(U const& u, vec<2, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> operator/(U const& u, vec<2, T> const& v1);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator+(vec<2, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator-(vec<2, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator*(vec<2, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator/(vec<2, T, Q> const& v, T const &s);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator+(vec<2, T, Q> const& v1, vec<2, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator-(vec<2, T, Q> const& v1, vec<2, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator*(vec<2, T, Q> const& v1, vec<2, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator/(vec<2, T, Q> const& v1, vec<2, T, Q> const &v2);
+
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator+(vec<2, T, Q> const& v1, U const& u);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator-(vec<2, T, Q> const& v1, U const& u);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator*(vec<2, T, Q> const& v1, U const& u);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator/(vec<2, T, Q> const& v1, U const& u);
+
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator+(U const& u, vec<2, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator-(U const& u, vec<2, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator*(U const& u, vec<2, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> operator/(U const& u, vec<2, T, Q> const& v1);
         
         // -- struct vec<3, T> --
 
-        template<typename T>
-        struct vec<3, T> {
+        template<typename T, qualifier Q>
+        struct alignas(detail::alignment<3, T, Q>::value) vec<3, T, Q> {
                 // -- Store data define --
 
+                /* 非 packed 时 data 含补齐通道 data[3]，整宽读写不越出数组；补齐通道始终为 0 */
                 union {
+                        T data[detail::lanes<3, Q>::value];
                         struct { T x, y, z; };
                         struct { T r, g, b; };
                 };
 
                 // -- Constructor for vec3 --
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec() VRT_FUNC_DEFAULT_CTOR;
-                VRT_FUNC_DECL explicit vec(T s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<2, T> const& v, T z);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec() requires (detail::lanes<3, Q>::value == 3) VRT_FUNC_DEFAULT_CTOR;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec() requires (detail::lanes<3, Q>::value == 4);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit vec(T s);
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<3, T, P> const& v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<2, T, Q> const& v, T z);
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(T x, T y, T z);
 
                 // -- Operator override --
 
-                template<typename U>
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> & operator=(vec<3, U> const& v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> & operator=(vec<3, T> const& v) VRT_FUNC_DEFAULT_CTOR;
+                template<typename U, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> & operator=(vec<3, U, P> const& v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> & operator=(vec<3, T, Q> const& v) VRT_FUNC_DEFAULT_CTOR;
                 
-                template<typename U>
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> & operator=(vec<4, U> const& v);
+                template<typename U, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> & operator=(vec<4, U, P> const& v);
                     
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T & operator[](size_t n);
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T const& operator[](size_t n) const;
                 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T>& operator+=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T>& operator-=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T>& operator*=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T>& operator/=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q>& operator+=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q>& operator-=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q>& operator*=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q>& operator/=(T const &s);
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T>& operator+=(vec<3, T> const &v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T>& operator-=(vec<3, T> const &v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T>& operator*=(vec<3, T> const &v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T>& operator/=(vec<3, T> const &v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q>& operator+=(vec<3, T, Q> const &v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q>& operator-=(vec<3, T, Q> const &v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q>& operator*=(vec<3, T, Q> const &v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q>& operator/=(vec<3, T, Q> const &v);
 
-                VRT_FUNC_DECL vec<2, T> xy();
+                VRT_FUNC_DECL vec<2, T, Q> xy();
                 
         };
 
         // -- struct vec<3, T>: Global operator overrides --
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator+(vec<3, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator-(vec<3, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator*(vec<3, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator/(vec<3, T> const& v, T const &s);
-
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator+(vec<3, T> const& v1, vec<3, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator-(vec<3, T> const& v1, vec<3, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator*(vec<3, T> const& v1, vec<3, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator/(vec<3, T> const& v1, vec<3, T> const &v2);
-
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator+(vec<3, T> const& v1, U const& u);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator-(vec<3, T> const& v1, U const& u);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator*(vec<3, T> const& v1, U const& u);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator/(vec<3, T> const& v1, U const& u);
-
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator+(U const& u, vec<3, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator-(U const& u, vec<3, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator*(U const& u, vec<3, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> operator/(U const& u, vec<3, T> const& v1);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator+(vec<3, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator-(vec<3, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator*(vec<3, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator/(vec<3, T, Q> const& v, T const &s);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator+(vec<3, T, Q> const& v1, vec<3, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator-(vec<3, T, Q> const& v1, vec<3, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator*(vec<3, T, Q> const& v1, vec<3, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator/(vec<3, T, Q> const& v1, vec<3, T, Q> const &v2);
+
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator+(vec<3, T, Q> const& v1, U const& u);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator-(vec<3, T, Q> const& v1, U const& u);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator*(vec<3, T, Q> const& v1, U const& u);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator/(vec<3, T, Q> const& v1, U const& u);
+
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator+(U const& u, vec<3, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator-(U const& u, vec<3, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator*(U const& u, vec<3, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> operator/(U const& u, vec<3, T, Q> const& v1);
         
         // -- struct vec<4, T> --
 
-        template<typename T>
-        struct vec<4, T> {
+        template<typename T, qualifier Q>
+        struct alignas(detail::alignment<4, T, Q>::value) vec<4, T, Q> {
                 // -- Store data define --
 
                 union {
+                        T data[4];
                         struct { T x, y, z, w; };
                         struct { T r, g, b, a; };
                 };
@@ -257,170 +488,373 @@ namespace vrt
                 // -- Constructor for vec4 --
 
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec() VRT_FUNC_DEFAULT_CTOR;
-                VRT_FUNC_DECL explicit vec(T s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<2, T> const& v, T z, T w);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<3, T> const& v, T w);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit vec(T s);
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<4, T, P> const& v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<2, T, Q> const& v, T z, T w);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<3, T, Q> const& v, T w);
                 VRT_FUNC_DECL VRT_INLINE VRT_FUNC_CONSTEXPR vec(T x, T y, T z, T w);
 
                 // -- Operator override --
 
-                template<typename U>
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> & operator=(vec<4, U> const& v);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> & operator=(vec<4, T> const& v) = default;
+                template<typename U, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> & operator=(vec<4, U, P> const& v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> & operator=(vec<4, T, Q> const& v) = default;
                 
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T & operator[](size_t n);
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T const& operator[](size_t n) const;
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T>& operator+=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T>& operator-=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T>& operator*=(T const &s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T>& operator/=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q>& operator+=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q>& operator-=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q>& operator*=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q>& operator/=(T const &s);
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T>& operator+=(vec<4, T> const &vv);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T>& operator-=(vec<4, T> const &vv);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T>& operator*=(vec<4, T> const &vv);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T>& operator/=(vec<4, T> const &vv);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q>& operator+=(vec<4, T, Q> const &vv);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q>& operator-=(vec<4, T, Q> const &vv);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q>& operator*=(vec<4, T, Q> const &vv);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q>& operator/=(vec<4, T, Q> const &vv);
                 
-                VRT_FUNC_DECL VRT_INLINE vec<2, T> xy();
-                VRT_FUNC_DECL VRT_INLINE vec<3, T> xyz();
+                VRT_FUNC_DECL VRT_INLINE vec<2, T, Q> xy();
+                VRT_FUNC_DECL VRT_INLINE vec<3, T, Q> xyz();
                 
         };
 
         // -- struct vec<4, T>: Global operator overrides --
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator+(vec<4, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator-(vec<4, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator*(vec<4, T> const& v, T const &s);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator/(vec<4, T> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator+(vec<4, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator-(vec<4, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator*(vec<4, T, Q> const& v, T const &s);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator/(vec<4, T, Q> const& v, T const &s);
         
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator+(vec<4, T> const& v1, vec<4, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator-(vec<4, T> const& v1, vec<4, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator*(vec<4, T> const& v1, vec<4, T> const &v2);
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator/(vec<4, T> const& v1, vec<4, T> const &v2);
-
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator+(U const& u, vec<4, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator-(U const& u, vec<4, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator*(U const& u, vec<4, T> const& v1);
-        template<typename T, typename U>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator/(U const& u, vec<4, T> const& v1);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator+(vec<4, T, Q> const& v1, vec<4, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator-(vec<4, T, Q> const& v1, vec<4, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator*(vec<4, T, Q> const& v1, vec<4, T, Q> const &v2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator/(vec<4, T, Q> const& v1, vec<4, T, Q> const &v2);
+
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator+(U const& u, vec<4, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator-(U const& u, vec<4, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator*(U const& u, vec<4, T, Q> const& v1);
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> operator/(U const& u, vec<4, T, Q> const& v1);
         
+        // -- struct vec<N, T> --
+
+        ///
+        /// @brief 任意长度的定长向量（N > 4），例如特征描述子、混合权重等 8 / 16 维数据。
+        ///
+        /// 存储为连续的 T data[N]，与 std::experimental::simd<T, fixed_size<N>> 的内存布局一致，
+        /// 所有逐分量运算都通过 detail::load / detail::store 整体加载为 simd 后计算，
+        /// 与 vec4 一样获得 SIMD 加速；常量求值时退化为逐分量循环。
+        ///
+        /// @tparam N 分量个数，2、3、4 使用上方的特化版本
+        /// @tparam T 分量类型
+        /// @tparam Q 存储限定符，aligned16 / aligned32 用于对齐加载，padded 与 packed 相同
+        ///
+        template<size_t N, typename T, qualifier Q>
+        struct alignas(detail::alignment<N, T, Q>::value) vec {
+                static_assert(N > 4, "vec<2..4> use the specialized versions");
+                static_assert(!detail::is_packet_v<T>, "packets are only supported for vec<2..4>");
+                static_assert(N <= std::experimental::simd_abi::max_fixed_size<T>, "vec size exceeds simd fixed_size limit");
+
+                // -- Store data define --
+
+                T data[N];
+
+                // -- Constructor for vecN --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec() VRT_FUNC_DEFAULT_CTOR;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit vec(T s);
+                template<qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec(vec<N, T, P> const& v);
+                template<typename... U>
+                requires (sizeof...(U) == N)
+                VRT_FUNC_DECL VRT_INLINE VRT_FUNC_CONSTEXPR vec(U... u);
+
+                // -- Operator override --
+
+                template<typename U, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> & operator=(vec<N, U, P> const& v);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> & operator=(vec<N, T, Q> const& v) = default;
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T & operator[](size_t n);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T const& operator[](size_t n) const;
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& operator+=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& operator-=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& operator*=(T const &s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& operator/=(T const &s);
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& operator+=(vec<N, T, Q> const &vv);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& operator-=(vec<N, T, Q> const &vv);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& operator*=(vec<N, T, Q> const &vv);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q>& operator/=(vec<N, T, Q> const &vv);
+        };
+
+        // -- struct vec<N, T>: Global operator overrides --
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator-(vec<N, T, Q> const& v);
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator+(vec<N, T, Q> const& v, T const &s);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator-(vec<N, T, Q> const& v, T const &s);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator*(vec<N, T, Q> const& v, T const &s);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator/(vec<N, T, Q> const& v, T const &s);
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator+(vec<N, T, Q> const& v1, vec<N, T, Q> const &v2);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator-(vec<N, T, Q> const& v1, vec<N, T, Q> const &v2);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator*(vec<N, T, Q> const& v1, vec<N, T, Q> const &v2);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator/(vec<N, T, Q> const& v1, vec<N, T, Q> const &v2);
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator+(T const &s, vec<N, T, Q> const& v);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator-(T const &s, vec<N, T, Q> const& v);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator*(T const &s, vec<N, T, Q> const& v);
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<N, T, Q> operator/(T const &s, vec<N, T, Q> const& v);
+
         // -- struct mat<2, T> --
 
-        template<typename T>
-        struct mat<2, T> {
+        template<typename T, qualifier Q>
+        struct mat<2, T, Q> {
                 // -- Data --
 
-                vec<2, T> data[2];
+                vec<2, T, Q> data[2];
 
                 // -- Constructor --
 
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat() VRT_FUNC_DEFAULT_CTOR;
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit mat<2, T>(T const& s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T>(
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit mat<2, T, Q>(T const& s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T, Q>(
                         T const& x1, T y1,
                         T const& x2, T y2);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T>(
-                        vec<2, T> const& c1,
-                        vec<2, T> const& c2);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T, Q>(
+                        vec<2, T, Q> const& c1,
+                        vec<2, T, Q> const& c2);
 
                 // -- Operator overrides --
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> & operator[](size_t n);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> const& operator[](size_t n) const;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> & operator[](size_t n);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> const& operator[](size_t n) const;
 
         };
 
+        // -- struct mat<2, T>: Global operator overrides --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T, Q> operator*(mat<2, T, Q> const& m, T const& v);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T, Q> operator*(mat<2, T, Q> const& m1, mat<2, T, Q> const& m2);
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, P> operator*(mat<2, T, Q> const& m, vec<2, T, P> const& v);
+
         // -- struct mat<3 T> --
 
-        template<typename T>
-        struct mat<3, T> {
+        template<typename T, qualifier Q>
+        struct mat<3, T, Q> {
                 // -- Data --
 
-                vec<3, T> data[3];
+                vec<3, T, Q> data[3];
 
                 // -- Constructor --
 
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat() VRT_FUNC_DEFAULT_CTOR;
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit mat<3, T>(T const& s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T>(
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit mat<3, T, Q>(T const& s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q>(
                     T const& x1, T y1, T const& z1,
                     T const& x2, T y2, T const& z2,
                     T const& x3, T y3, T const& z3);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T>(
-                    vec<3, T> const& c1,
-                    vec<3, T> const& c2,
-                    vec<3, T> const& c3);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q>(
+                    vec<3, T, Q> const& c1,
+                    vec<3, T, Q> const& c2,
+                    vec<3, T, Q> const& c3);
 
                 // -- Operator overrides --
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> & operator[](size_t n);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> const& operator[](size_t n) const;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> & operator[](size_t n);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> const& operator[](size_t n) const;
 
         };
+
+        // -- struct mat<3, T>: Global operator overrides --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q> operator*(mat<3, T, Q> const& m, T const& v);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q> operator*(mat<3, T, Q> const& m1, mat<3, T, Q> const& m2);
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> operator*(mat<3, T, Q> const& m, vec<3, T, P> const& v);
         
         // -- struct mat<4, T> --
         
-        template<typename T>
-        struct mat<4, T> {
+        template<typename T, qualifier Q>
+        struct mat<4, T, Q> {
                 // -- Data --
                 
-                vec<4, T> data[4];
+                vec<4, T, Q> data[4];
                 
                 // -- Constructor --
 
                 VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat() VRT_FUNC_DEFAULT_CTOR;
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit mat<4, T>(T const& s);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T>(
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit mat<4, T, Q>(T const& s);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>(
                         T const& x1, T y1, T const& z1, T const& w1,
                         T const& x2, T y2, T const& z2, T const& w2,
                         T const& x3, T y3, T const& z3, T const& w3,
                         T const& x4, T y4, T const& z4, T const& w4);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T>(
-                        vec<4, T> const& c1, 
-                        vec<4, T> const& c2, 
-                        vec<4, T> const& c3, 
-                        vec<4, T> const& c4);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>(
+                        vec<4, T, Q> const& c1, 
+                        vec<4, T, Q> const& c2, 
+                        vec<4, T, Q> const& c3, 
+                        vec<4, T, Q> const& c4);
                 
                 // -- Operator overrides --
 
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> & operator[](size_t n);
-                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> const& operator[](size_t n) const;
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> & operator[](size_t n);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> const& operator[](size_t n) const;
                 
         };
 
         // -- struct mat<4, T>: Global operator overrides --
         
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T> operator*(mat<4, T> const& m, T const& v);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> operator*(mat<4, T, Q> const& m, T const& v);
         
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T> operator*(mat<4, T> const& m1, mat<4, T> const& m2);
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> operator*(mat<4, T, Q> const& m1, mat<4, T, Q> const& m2);
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, P> operator*(mat<4, T, Q> const& m, vec<4, T, P> const& v);
+
+        // -- struct matrix<C, R, T> --
+
+        ///
+        /// @brief C 列 R 行的非方阵（C、R 为 2 ~ 4 且不相等），按列存储 C 个 vec<R, T>。
+        ///
+        /// 用于不需要齐次最后一行的紧凑变换：mat4x3 为三维仿射变换（48 字节，mat4 为 64 字节），
+        /// mat3x2 为二维仿射变换，mat3x4 为按行存储的骨骼矩阵（GPU 常用的 3 个 vec4）。
+        /// 乘法的形状在编译期检查：matrix<C, R> 只能右乘 C 行的矩阵或 vec<C>，
+        /// 结果为方阵时类型为 mat<N, T>（例如 mat3x4 * mat4x3 得到 mat4）。
+        ///
+        /// @tparam C 列数
+        /// @tparam R 行数
+        /// @tparam T 分量类型
+        /// @tparam Q 存储限定符，作用于每一列
+        ///
+        template<size_t C, size_t R, typename T, qualifier Q>
+        struct matrix {
+                static_assert(C >= 2 && C <= 4 && R >= 2 && R <= 4 && C != R, "matrix<C, R> is for 2 ~ 4 non-square shapes, use mat<N> for square matrices");
+
+                // -- Data --
+
+                vec<R, T, Q> data[C];
+
+                // -- Constructor --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR matrix() VRT_FUNC_DEFAULT_CTOR;
+
+                /* 对角线为 s，其余为 0 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit matrix(T const& s);
+
+                /* 按列构造，列数必须为 C */
+                template<typename... V>
+                requires (sizeof...(V) == C && (std::is_same_v<V, vec<R, T, Q>> && ...))
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR matrix(V const&... columns);
+
+                /* 从方阵截取左上部分，超出方阵的部分按单位矩阵补齐（例如 mat4x3(mat4) 去掉最后一行） */
+                template<size_t N, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit matrix(mat<N, T, P> const& m);
+
+                // -- Conversion --
+
+                /* 扩展或截取为方阵，缺少的部分按单位矩阵补齐（例如 mat4(mat4x3) 补上 (0, 0, 0, 1) 行） */
+                template<size_t N, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR explicit operator mat<N, T, P>() const;
+
+                // -- Operator overrides --
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<R, T, Q> & operator[](size_t n);
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<R, T, Q> const& operator[](size_t n) const;
+
+        };
+
+        // -- struct matrix<C, R, T>: Global operator overrides --
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR matrix<C, R, T, Q> operator*(matrix<C, R, T, Q> const& m, T const& v);
+
+        /* (C 列 R 行) * (K 列 C 行) = K 列 R 行，K == R 时结果为 mat<R, T> */
+        template<size_t C, size_t R, size_t K, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR detail::mat_t<K, R, T, Q> operator*(matrix<C, R, T, Q> const& m1, matrix<K, C, T, Q> const& m2);
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR matrix<C, R, T, Q> operator*(matrix<C, R, T, Q> const& m1, mat<C, T, Q> const& m2);
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR matrix<C, R, T, Q> operator*(mat<R, T, Q> const& m1, matrix<C, R, T, Q> const& m2);
+
+        /* 按列数分别重载，使其比 vec 的标量乘法 operator*(U, vec) 更特化 */
+        template<size_t R, typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<R, T, P> operator*(matrix<2, R, T, Q> const& m, vec<2, T, P> const& v);
+
+        template<size_t R, typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<R, T, P> operator*(matrix<3, R, T, Q> const& m, vec<3, T, P> const& v);
+
+        template<size_t R, typename T, qualifier Q, qualifier P>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<R, T, P> operator*(matrix<4, R, T, Q> const& m, vec<4, T, P> const& v);
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> operator*(mat<4, T> const& m, vec<4, T> const& v);
-        
         // -- struct vec<2, T>: implements --
 
-        template<typename T>
-        vec<2, T>::vec(T s) : vec(s, s) {}
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q>::vec(T s) : vec(s, s) {}
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T>::vec(T x, T y) : r(static_cast<T>(x)), g(static_cast<T>(y)) {}
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q>::vec(vec<2, T, P> const& v) : vec(v.x, v.y) {}
 
-        template<typename T>
-        template<typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> & vec<2, T>::operator=(vec<2, U> const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q>::vec(T x, T y) : x(static_cast<T>(x)), y(static_cast<T>(y)) {}
+
+        template<typename T, qualifier Q>
+        template<typename U, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> & vec<2, T, Q>::operator=(vec<2, U, P> const& v)
         {
                 this->x = static_cast<T>(v.x);
                 this->y = static_cast<T>(v.y);
@@ -428,9 +862,9 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        template<typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> & vec<2, T>::operator=(vec<3, U> const& v)
+        template<typename T, qualifier Q>
+        template<typename U, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> & vec<2, T, Q>::operator=(vec<3, U, P> const& v)
         {
                 this->x = static_cast<T>(v.x);
                 this->y = static_cast<T>(v.y);
@@ -438,200 +872,226 @@ namespace vrt
                 return *this;
         }
         
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T& vec<2, T>::operator[](size_t n)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T& vec<2, T, Q>::operator[](size_t n)
         {
-                switch (n) {
-                        case 0: return x;
-                        case 1: return y;
-                        default: throw std::runtime_error("out of index");
+                VRT_CHECK_INDEX(n, 2);
+
+                if consteval {
+                        /* 常量求值只能访问联合体的活动成员（x, y, z, w） */
+                        return n == 0 ? x : y;
+                } else {
+                        return data[n];
                 }
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T const& vec<2, T>::operator[](size_t n) const
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T const& vec<2, T, Q>::operator[](size_t n) const
         {
-                switch (n) {
-                        case 0: return x;
-                        case 1: return y;
-                        default: throw std::runtime_error("out of index");
+                VRT_CHECK_INDEX(n, 2);
+
+                if consteval {
+                        /* 常量求值只能访问联合体的活动成员（x, y, z, w） */
+                        return n == 0 ? x : y;
+                } else {
+                        return data[n];
                 }
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> &vec<2, T>::operator+=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> &vec<2, T, Q>::operator+=(T const &s)
         {
                 this->x = this->x + s;
                 this->y = this->y + s;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> &vec<2, T>::operator-=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> &vec<2, T, Q>::operator-=(T const &s)
         {
                 this->x = this->x - s;
                 this->y = this->y - s;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> &vec<2, T>::operator*=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> &vec<2, T, Q>::operator*=(T const &s)
         {
                 this->x = this->x * s;
                 this->y = this->y * s;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> &vec<2, T>::operator/=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> &vec<2, T, Q>::operator/=(T const &s)
         {
                 this->x = this->x / s;
                 this->y = this->y / s;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> &vec<2, T>::operator+=(const vec<2, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> &vec<2, T, Q>::operator+=(const vec<2, T, Q> &v)
         {
                 this->x = this->x + v.x;
                 this->y = this->y + v.y;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> &vec<2, T>::operator-=(const vec<2, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> &vec<2, T, Q>::operator-=(const vec<2, T, Q> &v)
         {
                 this->x = this->x - v.x;
                 this->y = this->y - v.y;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> &vec<2, T>::operator*=(const vec<2, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> &vec<2, T, Q>::operator*=(const vec<2, T, Q> &v)
         {
                 this->x = this->x * v.x;
                 this->y = this->y * v.y;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> &vec<2, T>::operator/=(const vec<2, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> &vec<2, T, Q>::operator/=(const vec<2, T, Q> &v)
         {
                 this->x = this->x / v.x;
                 this->y = this->y / v.y;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator+(vec<2, T> const& v, T const& s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator+(vec<2, T, Q> const& v, T const& s)
         {
-                return vec<2, T>(v.x + s, v.y + s);
+                return vec<2, T, Q>(v.x + s, v.y + s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator-(vec<2, T> const& v, T const& s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator-(vec<2, T, Q> const& v, T const& s)
         {
-                return vec<2, T>(v.x - s, v.y - s);
+                return vec<2, T, Q>(v.x - s, v.y - s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator*(vec<2, T> const& v, T const& s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator*(vec<2, T, Q> const& v, T const& s)
         {
-                return vec<2, T>(v.x * s, v.y * s);
+                return vec<2, T, Q>(v.x * s, v.y * s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator/(vec<2, T> const& v, T const& s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator/(vec<2, T, Q> const& v, T const& s)
         {
-                return vec<2, T>(v.x / s, v.y / s);
+                return vec<2, T, Q>(v.x / s, v.y / s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator+(vec<2, T> const& v1, vec<2, T> const& v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator+(vec<2, T, Q> const& v1, vec<2, T, Q> const& v2)
         {
-                return vec<2, T>(v1.x + v2.x, v1.y + v2.y);
+                return vec<2, T, Q>(v1.x + v2.x, v1.y + v2.y);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator-(vec<2, T> const& v1, vec<2, T> const& v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator-(vec<2, T, Q> const& v1, vec<2, T, Q> const& v2)
         {
-                return vec<2, T>(v1.x - v2.x, v1.y - v2.y);
+                return vec<2, T, Q>(v1.x - v2.x, v1.y - v2.y);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator*(vec<2, T> const& v1, vec<2, T> const& v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator*(vec<2, T, Q> const& v1, vec<2, T, Q> const& v2)
         {
-                return vec<2, T>(v1.x * v2.x, v1.y * v2.y);
+                return vec<2, T, Q>(v1.x * v2.x, v1.y * v2.y);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator/(vec<2, T> const& v1, vec<2, T> const& v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator/(vec<2, T, Q> const& v1, vec<2, T, Q> const& v2)
         {
-                return vec<2, T>(v1.x / v2.x, v1.y / v2.y);
+                return vec<2, T, Q>(v1.x / v2.x, v1.y / v2.y);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator+(vec<2, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator+(vec<2, T, Q> const& v, U const& u)
         {
-                return vec<2, T>(v.x + u, v.y + u);
+                return vec<2, T, Q>(v.x + u, v.y + u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator-(vec<2, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator-(vec<2, T, Q> const& v, U const& u)
         {
-                return vec<2, T>(v.x - u, v.y - u);
+                return vec<2, T, Q>(v.x - u, v.y - u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator*(vec<2, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator*(vec<2, T, Q> const& v, U const& u)
         {
-                return vec<2, T>(v.x * u, v.y * u);
+                return vec<2, T, Q>(v.x * u, v.y * u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator/(vec<2, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator/(vec<2, T, Q> const& v, U const& u)
         {
-                return vec<2, T>(v.x / u, v.y / u);
+                return vec<2, T, Q>(v.x / u, v.y / u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator+(U const& u, vec<2, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator+(U const& u, vec<2, T, Q> const& v)
         {
                 return v + u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator-(U const& u, vec<2, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator-(U const& u, vec<2, T, Q> const& v)
         {
                 return v - u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator*(U const& u, vec<2, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator*(U const& u, vec<2, T, Q> const& v)
         {
                 return v * u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator/(U const& u, vec<2, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> operator/(U const& u, vec<2, T, Q> const& v)
         {
                 return v / u;
         }
         
         // -- struct vec<3, T>: implements --
 
-        template<typename T>
-        vec<3, T>::vec(T s) : vec(s, s, s) {}
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q>::vec(T s) : vec(s, s, s) {}
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T>::vec(vec<2, T> const& v, T z) : vec(v.x, v.y, z) {}
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q>::vec(vec<3, T, P> const& v) : vec(v.x, v.y, v.z) {}
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T>::vec(T x, T y, T z) : r(static_cast<T>(x)), g(static_cast<T>(y)), b(static_cast<T>(z)) {}
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q>::vec(vec<2, T, Q> const& v, T z) : vec(v.x, v.y, z) {}
 
-        template<typename T>
-        template<typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> & vec<3, T>::operator=(vec<3, U> const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q>::vec() requires (detail::lanes<3, Q>::value == 4)
+        {
+                /* 常量求值只访问 x, y, z，补齐通道只需在运行时写入 */
+                if !consteval {
+                        data[3] = T(0);
+                }
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q>::vec(T x, T y, T z) : x(static_cast<T>(x)), y(static_cast<T>(y)), z(static_cast<T>(z))
+        {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                data[3] = T(0);
+                        }
+                }
+        }
+
+        template<typename T, qualifier Q>
+        template<typename U, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> & vec<3, T, Q>::operator=(vec<3, U, P> const& v)
         {
                 this->x = static_cast<T>(v.x);
                 this->y = static_cast<T>(v.y);
@@ -640,9 +1100,9 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        template<typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> & vec<3, T>::operator=(vec<4, U> const& v)
+        template<typename T, qualifier Q>
+        template<typename U, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> & vec<3, T, Q>::operator=(vec<4, U, P> const& v)
         {
                 this->x = static_cast<T>(v.x);
                 this->y = static_cast<T>(v.y);
@@ -651,222 +1111,351 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T& vec<3, T>::operator[](size_t n)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T& vec<3, T, Q>::operator[](size_t n)
         {
-                switch (n) {
-                        case 0: return x;
-                        case 1: return y;
-                        case 2: return z;
-                        default: throw std::runtime_error("out of index");
+                VRT_CHECK_INDEX(n, 3);
+
+                if consteval {
+                        /* 常量求值只能访问联合体的活动成员（x, y, z, w） */
+                        return n == 0 ? x : (n == 1 ? y : z);
+                } else {
+                        return data[n];
                 }
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T const& vec<3, T>::operator[](size_t n) const
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T const& vec<3, T, Q>::operator[](size_t n) const
         {
-                switch (n) {
-                        case 0: return x;
-                        case 1: return y;
-                        case 2: return z;
-                        default: throw std::runtime_error("out of index");
+                VRT_CHECK_INDEX(n, 3);
+
+                if consteval {
+                        /* 常量求值只能访问联合体的活动成员（x, y, z, w） */
+                        return n == 0 ? x : (n == 1 ? y : z);
+                } else {
+                        return data[n];
                 }
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> &vec<3, T>::operator+=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> &vec<3, T, Q>::operator+=(T const &s)
         {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        /* 补齐为 4 通道（padded / aligned16 / aligned32）时使用 simd；常量求值时 simd 不可用，走下面的逐分量实现 */
+                        if !consteval {
+                                detail::store(detail::load(*this) + s, *this);
+                                return *this;
+                        }
+                }
+
                 this->x = this->x + s;
                 this->y = this->y + s;
                 this->z = this->z + s;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> &vec<3, T>::operator-=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> &vec<3, T, Q>::operator-=(T const &s)
         {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                detail::store(detail::load(*this) - s, *this);
+                                return *this;
+                        }
+                }
+
                 this->x = this->x - s;
                 this->y = this->y - s;
                 this->z = this->z - s;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> &vec<3, T>::operator*=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> &vec<3, T, Q>::operator*=(T const &s)
         {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                detail::store(detail::load(*this) * s, *this);
+                                return *this;
+                        }
+                }
+
                 this->x = this->x * s;
                 this->y = this->y * s;
                 this->z = this->z * s;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> &vec<3, T>::operator/=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> &vec<3, T, Q>::operator/=(T const &s)
         {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                detail::store(detail::load(*this) / s, *this);
+                                return *this;
+                        }
+                }
+
                 this->x = this->x / s;
                 this->y = this->y / s;
                 this->z = this->z / s;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> &vec<3, T>::operator+=(const vec<3, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> &vec<3, T, Q>::operator+=(const vec<3, T, Q> &v)
         {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                detail::store(detail::load(*this) + detail::load(v), *this);
+                                return *this;
+                        }
+                }
+
                 this->x = this->x + v.x;
                 this->y = this->y + v.y;
                 this->z = this->z + v.z;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> &vec<3, T>::operator-=(const vec<3, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> &vec<3, T, Q>::operator-=(const vec<3, T, Q> &v)
         {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                detail::store(detail::load(*this) - detail::load(v), *this);
+                                return *this;
+                        }
+                }
+
                 this->x = this->x - v.x;
                 this->y = this->y - v.y;
                 this->z = this->z - v.z;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> &vec<3, T>::operator*=(const vec<3, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> &vec<3, T, Q>::operator*=(const vec<3, T, Q> &v)
         {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                detail::store(detail::load(*this) * detail::load(v), *this);
+                                return *this;
+                        }
+                }
+
                 this->x = this->x * v.x;
                 this->y = this->y * v.y;
                 this->z = this->z * v.z;
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> &vec<3, T>::operator/=(const vec<3, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> &vec<3, T, Q>::operator/=(const vec<3, T, Q> &v)
         {
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                detail::store(detail::load(*this) / detail::load(v), *this);
+                                return *this;
+                        }
+                }
+
                 this->x = this->x / v.x;
                 this->y = this->y / v.y;
                 this->z = this->z / v.z;
                 return *this;
         }
 
-        template<typename T>
-        vec<2, T> vec<3, T>::xy()
+        template<typename T, qualifier Q>
+        vec<2, T, Q> vec<3, T, Q>::xy()
         {
-                return vec<2, T>(x, y);
+                return vec<2, T, Q>(x, y);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator+(vec<3, T> const& v, T const& s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator+(vec<3, T, Q> const& v, T const& s)
         {
-                return vec<3, T>(v.x + s, v.y + s, v.z + s);
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, Q> Result;
+                                detail::store(detail::load(v) + s, Result);
+                                return Result;
+                        }
+                }
+
+                return vec<3, T, Q>(v.x + s, v.y + s, v.z + s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator-(vec<3, T> const& v, T const& s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator-(vec<3, T, Q> const& v, T const& s)
         {
-                return vec<3, T>(v.x - s, v.y - s, v.z - s);
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, Q> Result;
+                                detail::store(detail::load(v) - s, Result);
+                                return Result;
+                        }
+                }
+
+                return vec<3, T, Q>(v.x - s, v.y - s, v.z - s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator*(vec<3, T> const& v, T const& s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator*(vec<3, T, Q> const& v, T const& s)
         {
-                return vec<3, T>(v.x * s, v.y * s, v.z * s);
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, Q> Result;
+                                detail::store(detail::load(v) * s, Result);
+                                return Result;
+                        }
+                }
+
+                return vec<3, T, Q>(v.x * s, v.y * s, v.z * s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator/(vec<3, T> const& v, T const& s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator/(vec<3, T, Q> const& v, T const& s)
         {
-                return vec<3, T>(v.x / s, v.y / s, v.z / s);
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, Q> Result;
+                                detail::store(detail::load(v) / s, Result);
+                                return Result;
+                        }
+                }
+
+                return vec<3, T, Q>(v.x / s, v.y / s, v.z / s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator+(vec<3, T> const& v1, vec<3, T> const& v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator+(vec<3, T, Q> const& v1, vec<3, T, Q> const& v2)
         {
-                return vec<3, T>(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z);
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, Q> Result;
+                                detail::store(detail::load(v1) + detail::load(v2), Result);
+                                return Result;
+                        }
+                }
+
+                return vec<3, T, Q>(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator-(vec<3, T> const& v1, vec<3, T> const& v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator-(vec<3, T, Q> const& v1, vec<3, T, Q> const& v2)
         {
-                return vec<3, T>(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z);
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, Q> Result;
+                                detail::store(detail::load(v1) - detail::load(v2), Result);
+                                return Result;
+                        }
+                }
+
+                return vec<3, T, Q>(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator*(vec<3, T> const& v1, vec<3, T> const& v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator*(vec<3, T, Q> const& v1, vec<3, T, Q> const& v2)
         {
-                return vec<3, T>(v1.x * v2.x, v1.y * v2.y, v1.z * v2.z);
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, Q> Result;
+                                detail::store(detail::load(v1) * detail::load(v2), Result);
+                                return Result;
+                        }
+                }
+
+                return vec<3, T, Q>(v1.x * v2.x, v1.y * v2.y, v1.z * v2.z);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator/(vec<3, T> const& v1, vec<3, T> const& v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator/(vec<3, T, Q> const& v1, vec<3, T, Q> const& v2)
         {
-                return vec<3, T>(v1.x / v2.x, v1.y / v2.y, v1.z / v2.z);
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, Q> Result;
+                                detail::store(detail::load(v1) / detail::load(v2), Result);
+                                return Result;
+                        }
+                }
+
+                return vec<3, T, Q>(v1.x / v2.x, v1.y / v2.y, v1.z / v2.z);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator+(vec<3, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator+(vec<3, T, Q> const& v, U const& u)
         {
-                return vec<3, T>(v.x + u, v.y + u, v.z + u);
+                return vec<3, T, Q>(v.x + u, v.y + u, v.z + u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator-(vec<3, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator-(vec<3, T, Q> const& v, U const& u)
         {
-                return vec<3, T>(v.x - u, v.y - u, v.z - u);
+                return vec<3, T, Q>(v.x - u, v.y - u, v.z - u);
         }
         
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator*(vec<3, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator*(vec<3, T, Q> const& v, U const& u)
         {
-                return vec<3, T>(v.x * u, v.y * u, v.z * u);
+                return vec<3, T, Q>(v.x * u, v.y * u, v.z * u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator/(vec<3, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator/(vec<3, T, Q> const& v, U const& u)
         {
-                return vec<3, T>(v.x / u, v.y / u, v.z / u);
+                return vec<3, T, Q>(v.x / u, v.y / u, v.z / u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator+(U const& u, vec<3, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator+(U const& u, vec<3, T, Q> const& v)
         {
                 return v + u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator-(U const& u, vec<3, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator-(U const& u, vec<3, T, Q> const& v)
         {
                 return v - u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator*(U const& u, vec<3, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator*(U const& u, vec<3, T, Q> const& v)
         {
                 return v * u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator/(U const& u, vec<3, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> operator/(U const& u, vec<3, T, Q> const& v)
         {
                 return v / u;
         }
         
         // -- struct vec<4, T>: implements --
 
-        template<typename T>
-        vec<4, T>::vec(T s) : vec(s, s, s, s) {}
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q>::vec(T s) : vec(s, s, s, s) {}
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T>::vec(vec<2, T> const& v, T z, T w) : vec(v.x, v.y, z, w) {}
+        template<typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q>::vec(vec<4, T, P> const& v) : vec(v.x, v.y, v.z, v.w) {}
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T>::vec(vec<3, T> const& v, T w) : vec(v.x, v.y, v.z, w) {}
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q>::vec(vec<2, T, Q> const& v, T z, T w) : vec(v.x, v.y, z, w) {}
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T>::vec(T x, T y, T z, T w) 
-                : r(static_cast<T>(x)), g(static_cast<T>(y))
-                , b(static_cast<T>(z)), a(static_cast<T>(w))
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q>::vec(vec<3, T, Q> const& v, T w) : vec(v.x, v.y, v.z, w) {}
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q>::vec(T x, T y, T z, T w) 
+                : x(static_cast<T>(x)), y(static_cast<T>(y))
+                , z(static_cast<T>(z)), w(static_cast<T>(w))
         {}
 
-        template<typename T>
-        template<typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator=(vec<4, U> const& v)
+        template<typename T, qualifier Q>
+        template<typename U, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator=(vec<4, U, P> const& v)
         {
                 this->x = static_cast<T>(v.x);
                 this->y = static_cast<T>(v.y);
@@ -876,32 +1465,34 @@ namespace vrt
                 return *this;
         }
                 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T& vec<4, T>::operator[](size_t n)
-        {
-                switch (n) {
-                        case 0: return x;
-                        case 1: return y;
-                        case 2: return z;
-                        case 3: return w;
-                        default: throw std::runtime_error("out of index");
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T& vec<4, T, Q>::operator[](size_t n)
+        {
+                VRT_CHECK_INDEX(n, 4);
+
+                if consteval {
+                        /* 常量求值只能访问联合体的活动成员（x, y, z, w） */
+                        return n == 0 ? x : (n == 1 ? y : (n == 2 ? z : w));
+                } else {
+                        return data[n];
                 }
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T const& vec<4, T>::operator[](size_t n) const
-        {
-                switch (n) {
-                        case 0: return x;
-                        case 1: return y;
-                        case 2: return z;
-                        case 3: return w;
-                        default: throw std::runtime_error("out of index");
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T const& vec<4, T, Q>::operator[](size_t n) const
+        {
+                VRT_CHECK_INDEX(n, 4);
+
+                if consteval {
+                        /* 常量求值只能访问联合体的活动成员（x, y, z, w） */
+                        return n == 0 ? x : (n == 1 ? y : (n == 2 ? z : w));
+                } else {
+                        return data[n];
                 }
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator+=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator+=(T const &s)
         {
                 this->x = this->x + s;
                 this->y = this->y + s;
@@ -910,8 +1501,8 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator-=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator-=(T const &s)
         {
                 this->x = this->x - s;
                 this->y = this->y - s;
@@ -920,8 +1511,8 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator*=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator*=(T const &s)
         {
                 this->x = this->x * s;
                 this->y = this->y * s;
@@ -930,8 +1521,8 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator/=(T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator/=(T const &s)
         {
                 this->x = this->x / s;
                 this->y = this->y / s;
@@ -940,8 +1531,8 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator+=(const vec<4, T> &v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator+=(const vec<4, T, Q> &v2)
         {
                 this->x = this->x + v2.x;
                 this->y = this->y + v2.y;
@@ -950,8 +1541,8 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator-=(const vec<4, T> &v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator-=(const vec<4, T, Q> &v2)
         {
                 this->x = this->x - v2.x;
                 this->y = this->y - v2.y;
@@ -960,8 +1551,8 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator*=(const vec<4, T> &v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator*=(const vec<4, T, Q> &v2)
         {
                 this->x = this->x * v2.x;
                 this->y = this->y * v2.y;
@@ -970,8 +1561,8 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> & vec<4, T>::operator/=(const vec<4, T> &v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> & vec<4, T, Q>::operator/=(const vec<4, T, Q> &v2)
         {
                 this->x = this->x / v2.x;
                 this->y = this->y / v2.y;
@@ -980,155 +1571,463 @@ namespace vrt
                 return *this;
         }
 
-        template<typename T>
-        vec<2, T> vec<4, T>::xy()
+        template<typename T, qualifier Q>
+        vec<2, T, Q> vec<4, T, Q>::xy()
         {
-                return vec<2, T>(x, y);
+                return vec<2, T, Q>(x, y);
         }
 
-        template<typename T>
-        vec<3, T> vec<4, T>::xyz()
+        template<typename T, qualifier Q>
+        vec<3, T, Q> vec<4, T, Q>::xyz()
         {
-                return vec<3, T>(x, y, z);
+                return vec<3, T, Q>(x, y, z);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator+(vec<4, T> const& v, T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator+(vec<4, T, Q> const& v, T const &s)
         {
-                return vec<4, T>(v.x + s, v.y + s, v.z + s, v.w + s);
+                return vec<4, T, Q>(v.x + s, v.y + s, v.z + s, v.w + s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator-(vec<4, T> const& v, T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator-(vec<4, T, Q> const& v, T const &s)
         {
-                return vec<4, T>(v.x - s, v.y - s, v.z - s, v.w - s);
+                return vec<4, T, Q>(v.x - s, v.y - s, v.z - s, v.w - s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator*(vec<4, T> const& v, T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator*(vec<4, T, Q> const& v, T const &s)
         {
-                return vec<4, T>(v.x * s, v.y * s, v.z * s, v.w * s);
+                return vec<4, T, Q>(v.x * s, v.y * s, v.z * s, v.w * s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator/(vec<4, T> const& v, T const &s)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator/(vec<4, T, Q> const& v, T const &s)
         {
-                return vec<4, T>(v.x / s, v.y / s, v.z / s, v.w / s);
+                return vec<4, T, Q>(v.x / s, v.y / s, v.z / s, v.w / s);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator+(vec<4, T> const& v1, const vec<4, T> &v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator+(vec<4, T, Q> const& v1, const vec<4, T, Q> &v2)
         {
-                return vec<4, T>(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w);
+                return vec<4, T, Q>(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator-(vec<4, T> const& v1, const vec<4, T> &v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator-(vec<4, T, Q> const& v1, const vec<4, T, Q> &v2)
         {
-                return vec<4, T>(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.w - v2.w);
+                return vec<4, T, Q>(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.w - v2.w);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator*(vec<4, T> const& v1, const vec<4, T> &v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator*(vec<4, T, Q> const& v1, const vec<4, T, Q> &v2)
         {
-                return vec<4, T>(v1.x * v2.x, v1.y * v2.y, v1.z * v2.z, v1.w * v2.w);
+                return vec<4, T, Q>(v1.x * v2.x, v1.y * v2.y, v1.z * v2.z, v1.w * v2.w);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator/(vec<4, T> const& v1, const vec<4, T> &v2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator/(vec<4, T, Q> const& v1, const vec<4, T, Q> &v2)
         {
-                return vec<4, T>(v1.x / v2.x, v1.y / v2.y, v1.z / v2.z, v1.w / v2.w);
+                return vec<4, T, Q>(v1.x / v2.x, v1.y / v2.y, v1.z / v2.z, v1.w / v2.w);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator+(vec<4, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator+(vec<4, T, Q> const& v, U const& u)
         {
-                return vec<4, T>(v.x + u, v.y + u, v.z + u, v.w + u);
+                return vec<4, T, Q>(v.x + u, v.y + u, v.z + u, v.w + u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator-(vec<4, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator-(vec<4, T, Q> const& v, U const& u)
         {
-                return vec<4, T>(v.x - u, v.y - u, v.z - u, v.w - u);
+                return vec<4, T, Q>(v.x - u, v.y - u, v.z - u, v.w - u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator*(vec<4, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator*(vec<4, T, Q> const& v, U const& u)
         {
-                return vec<4, T>(v.x * u, v.y * u, v.z * u, v.w * u);
+                return vec<4, T, Q>(v.x * u, v.y * u, v.z * u, v.w * u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator/(vec<4, T> const& v, U const& u)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator/(vec<4, T, Q> const& v, U const& u)
         {
-                return vec<4, T>(v.x / u, v.y / u, v.z / u, v.w / u);
+                return vec<4, T, Q>(v.x / u, v.y / u, v.z / u, v.w / u);
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator+(U const& u, vec<4, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator+(U const& u, vec<4, T, Q> const& v)
         {
                 return v + u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator-(U const& u, vec<4, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator-(U const& u, vec<4, T, Q> const& v)
         {
                 return v - u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator*(U const& u, vec<4, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator*(U const& u, vec<4, T, Q> const& v)
         {
                 return v * u;
         }
 
-        template<typename T, typename U>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator/(U const& u, vec<4, T> const& v)
+        template<typename T, qualifier Q, typename U>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> operator/(U const& u, vec<4, T, Q> const& v)
         {
                 return v / u;
         }
 
+        // -- struct vec<N, T>: implements --
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q>::vec(T s)
+        {
+                for (size_t i = 0; i < N; i++)
+                        data[i] = s;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        template<qualifier P>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q>::vec(vec<N, T, P> const& v)
+        {
+                for (size_t i = 0; i < N; i++)
+                        data[i] = v.data[i];
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        template<typename... U>
+        requires (sizeof...(U) == N)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q>::vec(U... u) : data{ static_cast<T>(u)... } {}
+
+        template<size_t N, typename T, qualifier Q>
+        template<typename U, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator=(vec<N, U, P> const& v)
+        {
+                for (size_t i = 0; i < N; i++)
+                        data[i] = static_cast<T>(v.data[i]);
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T& vec<N, T, Q>::operator[](size_t n)
+        {
+                VRT_CHECK_INDEX(n, N);
+                return data[n];
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T const& vec<N, T, Q>::operator[](size_t n) const
+        {
+                VRT_CHECK_INDEX(n, N);
+                return data[n];
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator+=(T const &s)
+        {
+                if consteval {
+                        for (size_t i = 0; i < N; i++)
+                                data[i] = data[i] + s;
+                } else {
+                        detail::store(detail::load(*this) + s, *this);
+                }
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator-=(T const &s)
+        {
+                if consteval {
+                        for (size_t i = 0; i < N; i++)
+                                data[i] = data[i] - s;
+                } else {
+                        detail::store(detail::load(*this) - s, *this);
+                }
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator*=(T const &s)
+        {
+                if consteval {
+                        for (size_t i = 0; i < N; i++)
+                                data[i] = data[i] * s;
+                } else {
+                        detail::store(detail::load(*this) * s, *this);
+                }
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator/=(T const &s)
+        {
+                if consteval {
+                        for (size_t i = 0; i < N; i++)
+                                data[i] = data[i] / s;
+                } else {
+                        detail::store(detail::load(*this) / s, *this);
+                }
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator+=(vec<N, T, Q> const &v2)
+        {
+                if consteval {
+                        for (size_t i = 0; i < N; i++)
+                                data[i] = data[i] + v2.data[i];
+                } else {
+                        detail::store(detail::load(*this) + detail::load(v2), *this);
+                }
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator-=(vec<N, T, Q> const &v2)
+        {
+                if consteval {
+                        for (size_t i = 0; i < N; i++)
+                                data[i] = data[i] - v2.data[i];
+                } else {
+                        detail::store(detail::load(*this) - detail::load(v2), *this);
+                }
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator*=(vec<N, T, Q> const &v2)
+        {
+                if consteval {
+                        for (size_t i = 0; i < N; i++)
+                                data[i] = data[i] * v2.data[i];
+                } else {
+                        detail::store(detail::load(*this) * detail::load(v2), *this);
+                }
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> & vec<N, T, Q>::operator/=(vec<N, T, Q> const &v2)
+        {
+                if consteval {
+                        for (size_t i = 0; i < N; i++)
+                                data[i] = data[i] / v2.data[i];
+                } else {
+                        detail::store(detail::load(*this) / detail::load(v2), *this);
+                }
+
+                return *this;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator-(vec<N, T, Q> const& v)
+        {
+                return T(0) - v;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator+(vec<N, T, Q> const& v, T const &s)
+        {
+                vec<N, T, Q> Result(v);
+                return Result += s;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator-(vec<N, T, Q> const& v, T const &s)
+        {
+                vec<N, T, Q> Result(v);
+                return Result -= s;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator*(vec<N, T, Q> const& v, T const &s)
+        {
+                vec<N, T, Q> Result(v);
+                return Result *= s;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator/(vec<N, T, Q> const& v, T const &s)
+        {
+                vec<N, T, Q> Result(v);
+                return Result /= s;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator+(vec<N, T, Q> const& v1, vec<N, T, Q> const &v2)
+        {
+                vec<N, T, Q> Result(v1);
+                return Result += v2;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator-(vec<N, T, Q> const& v1, vec<N, T, Q> const &v2)
+        {
+                vec<N, T, Q> Result(v1);
+                return Result -= v2;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator*(vec<N, T, Q> const& v1, vec<N, T, Q> const &v2)
+        {
+                vec<N, T, Q> Result(v1);
+                return Result *= v2;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator/(vec<N, T, Q> const& v1, vec<N, T, Q> const &v2)
+        {
+                vec<N, T, Q> Result(v1);
+                return Result /= v2;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator+(T const &s, vec<N, T, Q> const& v)
+        {
+                vec<N, T, Q> Result(s);
+                return Result += v;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator-(T const &s, vec<N, T, Q> const& v)
+        {
+                vec<N, T, Q> Result(s);
+                return Result -= v;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator*(T const &s, vec<N, T, Q> const& v)
+        {
+                vec<N, T, Q> Result(s);
+                return Result *= v;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        requires (N > 4)
+        VRT_FUNC_CONSTEXPR vec<N, T, Q> operator/(T const &s, vec<N, T, Q> const& v)
+        {
+                vec<N, T, Q> Result(s);
+                return Result /= v;
+        }
+
+        // -- detail implements --
+
+        namespace detail
+        {
+                template<size_t N, typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_FORCE_INLINE simd_t<N, T, Q> load(vec<N, T, Q> const& v)
+                {
+                        using namespace std::experimental;
+
+                        if constexpr (is_packet_v<T>) {
+                                static_assert(std::is_trivially_copyable_v<T>, "packet width exceeds the native simd width of the target");
+                                return v;
+                        }
+                        else if constexpr (Q == packed)
+                                return simd_t<N, T, Q>(v.data, element_aligned);
+                        else
+                                return simd_t<N, T, Q>(v.data, overaligned<alignment<N, T, Q>::value>);
+                }
+
+                template<size_t N, typename T, qualifier Q, typename Abi>
+                VRT_FUNC_DECL VRT_FORCE_INLINE void store(std::experimental::simd<T, Abi> data, vec<N, T, Q>& v)
+                {
+                        using namespace std::experimental;
+
+                        if constexpr (simd_size_v<T, Abi> != lanes<N, Q>::value) {
+                                /* 通道数不一致（例如 aligned16 矩阵乘以 packed 向量），逐分量写回 */
+                                for (size_t i = 0; i < N; i++)
+                                        v.data[i] = data[i];
+                                return;
+                        } else if constexpr (lanes<N, Q>::value > N) {
+                                /* 补齐通道始终写回 0：与编译期常量的位掩码按位与（andps），不在运行时生成下标比较 */
+                                using U = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+                                simd<U, Abi> keep([](auto i) { return i < N ? ~U(0) : U(0); });
+                                data = __proposed::simd_bit_cast<simd<T, Abi>>(__proposed::simd_bit_cast<simd<U, Abi>>(data) & keep);
+                        }
+
+                        if constexpr (Q == packed)
+                                data.copy_to(v.data, element_aligned);
+                        else
+                                data.copy_to(v.data, overaligned<alignment<N, T, Q>::value>);
+                }
+
+                template<size_t N, typename T, qualifier Q, qualifier P>
+                requires is_packet_v<T>
+                VRT_FUNC_DECL VRT_FORCE_INLINE void store(vec<N, T, P> const& data, vec<N, T, Q>& v)
+                {
+                        for (size_t i = 0; i < N; i++)
+                                v.data[i] = data.data[i];
+                }
+        }
+
         // -- struct mat<2, T> --
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T>::mat(T const& s)
-            : mat(vec<2, T>(s, 0),
-                  vec<2, T>(0, s))
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T, Q>::mat(T const& s)
+            : mat(vec<2, T, Q>(s, 0),
+                  vec<2, T, Q>(0, s))
         {}
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T>::mat(
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T, Q>::mat(
             T const& x1, T y1,
             T const& x2, T y2)
-            : mat(vec<2, T>(x1, y1),
-                  vec<2, T>(x2, y2))
+            : mat(vec<2, T, Q>(x1, y1),
+                  vec<2, T, Q>(x2, y2))
         {}
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T>::mat(
-            vec<2, T> const& c1,
-            vec<2, T> const& c2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T, Q>::mat(
+            vec<2, T, Q> const& c1,
+            vec<2, T, Q> const& c2)
         {
                 data[0] = c1;
                 data[1] = c2;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T>& mat<2, T>::operator[](size_t n)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q>& mat<2, T, Q>::operator[](size_t n)
         {
+                VRT_CHECK_INDEX(n, 2);
+
                 return data[n];
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> const& mat<2, T>::operator[](size_t n) const
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> const& mat<2, T, Q>::operator[](size_t n) const
         {
+                VRT_CHECK_INDEX(n, 2);
+
                 return data[n];
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR mat<2, T> operator*(mat<2, T> const& m, T const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<2, T, Q> operator*(mat<2, T, Q> const& m, T const& v)
         {
-                mat<2, T> Result;
+                mat<2, T, Q> Result;
 
                 for (int i = 0; i < 2; i++)
                         Result[i] = m[i] * v;
@@ -1136,90 +2035,97 @@ namespace vrt
                 return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR mat<2, T> operator*(mat<2, T> const& m1, mat<2, T> const& m2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<2, T, Q> operator*(mat<2, T, Q> const& m1, mat<2, T, Q> const& m2)
         {
-                using namespace std::experimental;
+                mat<2, T, Q> Result;
 
-                mat<2, T> Result;
+                /* 常量求值时 simd 不可用，按列逐个组合 */
+                if consteval {
+                        for (int j = 0; j < 2; j++)
+                                Result[j] = m1[0] * m2[j].x + m1[1] * m2[j].y;
 
-                for (int j = 0; j < 2; j++) {
-                        simd<T, simd_abi::fixed_size<2>> col(&m2[j].x, element_aligned);
-                        for (int i = 0; i < 2; i++) {
-                                T row_data[] = { m1[0][i], m1[1][i] };
-                                simd<T, simd_abi::fixed_size<2>> row;
-                                row.copy_from(row_data, element_aligned);
-                                Result[j][i] = std::experimental::reduce(row * col);
-                        }
+                        return Result;
                 }
 
+                detail::simd_t<2, T, Q> c0 = detail::load(m1[0]);
+                detail::simd_t<2, T, Q> c1 = detail::load(m1[1]);
+
+                detail::store(c0 * m2[0].x + c1 * m2[0].y, Result[0]);
+                detail::store(c0 * m2[1].x + c1 * m2[1].y, Result[1]);
+
                 return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> operator*(mat<2, T> const& m, vec<2, T> const& v)
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<2, T, P> operator*(mat<2, T, Q> const& m, vec<2, T, P> const& v)
         {
-                using namespace std::experimental;
+                if consteval {
+                        return vec<2, T, P>(m[0].x * v.x + m[1].x * v.y,
+                                            m[0].y * v.x + m[1].y * v.y);
+                }
 
-                vec<2, T> Result;
+                vec<2, T, P> Result;
 
-                simd<T, simd_abi::fixed_size<2>> col(&v.x, element_aligned);
-                for (int i = 0; i < 2; i++) {
-                        T row_data[] = { m[0][i], m[1][i] };
-                        simd<T, simd_abi::fixed_size<2>> row;
-                        row.copy_from(row_data, element_aligned);
-                        Result[i] = std::experimental::reduce(row * col);
-                }
+                /* 列组合：Result = m[0] * v.x + m[1] * v.y */
+                detail::simd_t<2, T, Q> c0 = detail::load(m[0]);
+                detail::simd_t<2, T, Q> c1 = detail::load(m[1]);
+
+                detail::store(c0 * v.x + c1 * v.y, Result);
 
                 return Result;
         }
 
         // -- struct mat<3, T> --
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T>::mat(T const& s)
-            : mat(vec<3, T>(s, 0, 0),
-                  vec<3, T>(0, s, 0),
-                  vec<3, T>(0, 0, s))
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q>::mat(T const& s)
+            : mat(vec<3, T, Q>(s, 0, 0),
+                  vec<3, T, Q>(0, s, 0),
+                  vec<3, T, Q>(0, 0, s))
         {}
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T>::mat(
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q>::mat(
             T const& x1, T y1, T const& z1,
             T const& x2, T y2, T const& z2,
             T const& x3, T y3, T const& z3)
-            : mat(vec<3, T>(x1, y1, z1),
-                  vec<3, T>(x2, y2, z2),
-                  vec<3, T>(x3, y3, z3))
+            : mat(vec<3, T, Q>(x1, y1, z1),
+                  vec<3, T, Q>(x2, y2, z2),
+                  vec<3, T, Q>(x3, y3, z3))
         {}
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T>::mat(
-            vec<3, T> const& c1,
-            vec<3, T> const& c2,
-            vec<3, T> const& c3)
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q>::mat(
+            vec<3, T, Q> const& c1,
+            vec<3, T, Q> const& c2,
+            vec<3, T, Q> const& c3)
         {
                 data[0] = c1;
                 data[1] = c2;
                 data[2] = c3;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T>& mat<3, T>::operator[](size_t n)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q>& mat<3, T, Q>::operator[](size_t n)
         {
+                VRT_CHECK_INDEX(n, 3);
+
                 return data[n];
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> const& mat<3, T>::operator[](size_t n) const
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> const& mat<3, T, Q>::operator[](size_t n) const
         {
+                VRT_CHECK_INDEX(n, 3);
+
                 return data[n];
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR mat<3, T> operator*(mat<3, T> const& m, T const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<3, T, Q> operator*(mat<3, T, Q> const& m, T const& v)
         {
-                mat<3, T> Result;
+                mat<3, T, Q> Result;
 
                 for (int i = 0; i < 3; i++)
                         Result[i] = m[i] * v;
@@ -1227,72 +2133,83 @@ namespace vrt
                 return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR mat<3, T> operator*(mat<3, T> const& m1, mat<3, T> const& m2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<3, T, Q> operator*(mat<3, T, Q> const& m1, mat<3, T, Q> const& m2)
         {
-                using namespace std::experimental;
+                mat<3, T, Q> Result;
+
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        /* 列补齐为 4 通道时整列加载；packed 的 3 通道列按 fixed_size<3> 加载比逐分量慢，走下面的实现 */
+                        if !consteval {
+                                detail::simd_t<3, T, Q> c0 = detail::load(m1[0]);
+                                detail::simd_t<3, T, Q> c1 = detail::load(m1[1]);
+                                detail::simd_t<3, T, Q> c2 = detail::load(m1[2]);
 
-                mat<3, T> Result;
+                                detail::store(c0 * m2[0].x + c1 * m2[0].y + c2 * m2[0].z, Result[0]);
+                                detail::store(c0 * m2[1].x + c1 * m2[1].y + c2 * m2[1].z, Result[1]);
+                                detail::store(c0 * m2[2].x + c1 * m2[2].y + c2 * m2[2].z, Result[2]);
 
-                for (int j = 0; j < 3; j++) {
-                        simd<T, simd_abi::fixed_size<3>> col(&m2[j].x, element_aligned);
-                        for (int i = 0; i < 3; i++) {
-                                T row_data[] = { m1[0][i], m1[1][i], m1[2][i], m1[3][i] };
-                                simd<T, simd_abi::fixed_size<3>> row;
-                                row.copy_from(row_data, element_aligned);
-                                Result[j][i] = std::experimental::reduce(row * col);
+                                return Result;
                         }
                 }
 
+                for (int j = 0; j < 3; j++)
+                        Result[j] = m1[0] * m2[j].x + m1[1] * m2[j].y + m1[2] * m2[j].z;
+
                 return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> operator*(mat<3, T> const& m, vec<3, T> const& v)
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> operator*(mat<3, T, Q> const& m, vec<3, T, P> const& v)
         {
-                using namespace std::experimental;
+                if constexpr (detail::lanes<3, Q>::value == 4) {
+                        if !consteval {
+                                vec<3, T, P> Result;
+
+                                /* 列组合：Result = m[0] * v.x + m[1] * v.y + m[2] * v.z */
+                                detail::simd_t<3, T, Q> c0 = detail::load(m[0]);
+                                detail::simd_t<3, T, Q> c1 = detail::load(m[1]);
+                                detail::simd_t<3, T, Q> c2 = detail::load(m[2]);
 
-                vec<3, T> Result;
+                                detail::store(c0 * v.x + c1 * v.y + c2 * v.z, Result);
 
-                simd<T, simd_abi::fixed_size<3>> col(&v.x, element_aligned);
-                for (int i = 0; i < 3; i++) {
-                        T row_data[] = { m[0][i], m[1][i], m[2][i] };
-                        simd<T, simd_abi::fixed_size<3>> row;
-                        row.copy_from(row_data, element_aligned);
-                        Result[i] = std::experimental::reduce(row * col);
+                                return Result;
+                        }
                 }
 
-                return Result;
+                return vec<3, T, P>(m[0].x * v.x + m[1].x * v.y + m[2].x * v.z,
+                                    m[0].y * v.x + m[1].y * v.y + m[2].y * v.z,
+                                    m[0].z * v.x + m[1].z * v.y + m[2].z * v.z);
         }
         
         // -- struct mat<4, T> --
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T>::mat(T const& s)
-                : mat(vec<4, T>(s, 0, 0, 0),
-                      vec<4, T>(0, s, 0, 0),
-                      vec<4, T>(0, 0, s, 0),
-                      vec<4, T>(0, 0, 0, s))
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>::mat(T const& s)
+                : mat(vec<4, T, Q>(s, 0, 0, 0),
+                      vec<4, T, Q>(0, s, 0, 0),
+                      vec<4, T, Q>(0, 0, s, 0),
+                      vec<4, T, Q>(0, 0, 0, s))
         {}
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T>::mat(
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>::mat(
                 T const& x1, T y1, T const& z1, T const& w1,
                 T const& x2, T y2, T const& z2, T const& w2,
                 T const& x3, T y3, T const& z3, T const& w3,
                 T const& x4, T y4, T const& z4, T const& w4)
-                : mat(vec<4, T>(x1, y1, z1, w1),
-                      vec<4, T>(x2, y2, z2, w2),
-                      vec<4, T>(x3, y3, z3, w3),
-                      vec<4, T>(x4, y4, z4, w4))
+                : mat(vec<4, T, Q>(x1, y1, z1, w1),
+                      vec<4, T, Q>(x2, y2, z2, w2),
+                      vec<4, T, Q>(x3, y3, z3, w3),
+                      vec<4, T, Q>(x4, y4, z4, w4))
         {}
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T>::mat(
-                vec<4, T> const& c1,
-                vec<4, T> const& c2,
-                vec<4, T> const& c3,
-                vec<4, T> const& c4)
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>::mat(
+                vec<4, T, Q> const& c1,
+                vec<4, T, Q> const& c2,
+                vec<4, T, Q> const& c3,
+                vec<4, T, Q> const& c4)
         {
                 data[0] = c1;
                 data[1] = c2;
@@ -1300,22 +2217,26 @@ namespace vrt
                 data[3] = c4;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T>& mat<4, T>::operator[](size_t n)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q>& mat<4, T, Q>::operator[](size_t n)
         {
+                VRT_CHECK_INDEX(n, 4);
+
                 return data[n];
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> const& mat<4, T>::operator[](size_t n) const
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> const& mat<4, T, Q>::operator[](size_t n) const
         {
+                VRT_CHECK_INDEX(n, 4);
+
                 return data[n];
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR mat<4, T> operator*(mat<4, T> const& m, T const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> operator*(mat<4, T, Q> const& m, T const& v)
         {
-                mat<4, T> Result;
+                mat<4, T, Q> Result;
 
                 for (int i = 0; i < 4; i++)
                         Result[i] = m[i] * v;
@@ -1323,95 +2244,445 @@ namespace vrt
                 return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR mat<4, T> operator*(mat<4, T> const& m1, mat<4, T> const& m2)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> operator*(mat<4, T, Q> const& m1, mat<4, T, Q> const& m2)
         {
-                using namespace std::experimental;
+                mat<4, T, Q> Result;
 
-                mat<4, T> Result;
+                if consteval {
+                        for (int j = 0; j < 4; j++)
+                                Result[j] = m1[0] * m2[j].x + m1[1] * m2[j].y + m1[2] * m2[j].z + m1[3] * m2[j].w;
 
-                for (int j = 0; j < 4; j++) {
-                        simd<T, simd_abi::fixed_size<4>> col(&m2[j].x, element_aligned);
-                        for (int i = 0; i < 4; i++) {
-                                T row_data[] = { m1[0][i], m1[1][i], m1[2][i], m1[3][i] };
-                                simd<T, simd_abi::fixed_size<4>> row;
-                                row.copy_from(row_data, element_aligned);
-                                Result[j][i] = std::experimental::reduce(row * col);
-                        }
+                        return Result;
                 }
 
+                /* m1 的四列常驻寄存器，结果的第 j 列 = Σ m1[k] * m2[j][k]（列广播乘加） */
+                detail::simd_t<4, T, Q> c0 = detail::load(m1[0]);
+                detail::simd_t<4, T, Q> c1 = detail::load(m1[1]);
+                detail::simd_t<4, T, Q> c2 = detail::load(m1[2]);
+                detail::simd_t<4, T, Q> c3 = detail::load(m1[3]);
+
+                detail::store(c0 * m2[0].x + c1 * m2[0].y + c2 * m2[0].z + c3 * m2[0].w, Result[0]);
+                detail::store(c0 * m2[1].x + c1 * m2[1].y + c2 * m2[1].z + c3 * m2[1].w, Result[1]);
+                detail::store(c0 * m2[2].x + c1 * m2[2].y + c2 * m2[2].z + c3 * m2[2].w, Result[2]);
+                detail::store(c0 * m2[3].x + c1 * m2[3].y + c2 * m2[3].z + c3 * m2[3].w, Result[3]);
+
                 return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> operator*(mat<4, T> const& m, vec<4, T> const& v)
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<4, T, P> operator*(mat<4, T, Q> const& m, vec<4, T, P> const& v)
         {
-                using namespace std::experimental;
+                if consteval {
+                        return vec<4, T, P>(m[0].x * v.x + m[1].x * v.y + m[2].x * v.z + m[3].x * v.w,
+                                            m[0].y * v.x + m[1].y * v.y + m[2].y * v.z + m[3].y * v.w,
+                                            m[0].z * v.x + m[1].z * v.y + m[2].z * v.z + m[3].z * v.w,
+                                            m[0].w * v.x + m[1].w * v.y + m[2].w * v.z + m[3].w * v.w);
+                }
+
+                vec<4, T, P> Result;
+
+                /* 列组合：Result = m[0] * v.x + m[1] * v.y + m[2] * v.z + m[3] * v.w */
+                detail::simd_t<4, T, Q> c0 = detail::load(m[0]);
+                detail::simd_t<4, T, Q> c1 = detail::load(m[1]);
+                detail::simd_t<4, T, Q> c2 = detail::load(m[2]);
+                detail::simd_t<4, T, Q> c3 = detail::load(m[3]);
+
+                detail::store(c0 * v.x + c1 * v.y + c2 * v.z + c3 * v.w, Result);
+
+                return Result;
+        }
+
+        // -- detail: matrix product --
+
+        namespace detail
+        {
+                template<size_t C, size_t R, typename T, qualifier Q, typename A>
+                VRT_FUNC_DECL VRT_INLINE column_t<R, T, Q> load_column(A const& a, size_t k)
+                {
+                        using namespace std::experimental;
+
+                        if constexpr (column_kind_of<R, T, Q>() == column_kind::overlap) {
+                                static_assert(C > 1 && sizeof(A) == C * 3 * sizeof(T), "packed vec3 columns must be contiguous");
+
+                                /* 经由整个矩阵对象的字节表示读取，跨越列（vec3 成员）的指针运算是未定义行为 */
+                                std::byte const* p = reinterpret_cast<std::byte const*>(&a);
+                                T t[4];
+
+                                if (k + 1 < C) {
+                                        std::memcpy(t, p + 3 * k * sizeof(T), 4 * sizeof(T));
+                                        return column_t<R, T, Q>(t, element_aligned);
+                                }
+
+                                /* 最后一列向前多读一个元素（仍在对象内），整宽载入后在寄存器内移位 */
+                                std::memcpy(t, p + (3 * k - 1) * sizeof(T), 4 * sizeof(T));
+                                column_t<R, T, Q> c(t, element_aligned);
+
+                                return column_t<R, T, Q>([&] (auto i) { return T(c[i < 3 ? i + 1 : 3]); });
+                        } else {
+                                return load(a[k]);
+                        }
+                }
+
+                template<size_t C, size_t K, size_t R, typename T, qualifier Q, typename A, typename B, typename M>
+                VRT_FUNC_CONSTEXPR void mul_columns(A const& a, B const& b, M& Result)
+                {
+                        constexpr column_kind kind = column_kind_of<R, T, Q>();
+
+                        if constexpr (kind != column_kind::scalar) {
+                                if !consteval {
+                                        column_t<R, T, Q> col[C];
+
+                                        for (size_t k = 0; k < C; k++)
+                                                col[k] = load_column<C, R, T, Q>(a, k);
+
+                                        for (size_t j = 0; j < K; j++) {
+                                                column_t<R, T, Q> c = col[0] * b[j][0];
+
+                                                for (size_t k = 1; k < C; k++)
+                                                        c += col[k] * b[j][k];
+
+                                                if constexpr (kind == column_kind::overlap)
+                                                        Result[j] = vec<R, T, Q>(c[0], c[1], c[2]);
+                                                else
+                                                        store(c, Result[j]);
+                                        }
+
+                                        return;
+                                }
+                        }
+
+                        /* 常量求值时 simd 不可用，与窄列一样逐分量计算 */
+                        for (size_t j = 0; j < K; j++) {
+                                Result[j] = make_vec<R, T, Q>([&] (size_t r) {
+                                        T x = a[0][r] * b[j][0];
+
+                                        for (size_t k = 1; k < C; k++)
+                                                x += a[k][r] * b[j][k];
+
+                                        return x;
+                                });
+                        }
+                }
+
+                template<size_t C, size_t R, typename T, qualifier Q, qualifier P>
+                VRT_FUNC_CONSTEXPR vec<R, T, P> mul_vector(matrix<C, R, T, Q> const& m, vec<C, T, P> const& v)
+                {
+                        constexpr column_kind kind = column_kind_of<R, T, Q>();
+
+                        if constexpr (kind != column_kind::scalar) {
+                                if !consteval {
+                                        /* 列组合：Result = m[0] * v.x + m[1] * v.y + ... */
+                                        column_t<R, T, Q> c = load_column<C, R, T, Q>(m, 0) * v[0];
+
+                                        for (size_t k = 1; k < C; k++)
+                                                c += load_column<C, R, T, Q>(m, k) * v[k];
 
-                vec<4, T> Result;
+                                        if constexpr (kind == column_kind::overlap) {
+                                                return vec<R, T, P>(c[0], c[1], c[2]);
+                                        } else {
+                                                vec<R, T, P> Result;
+                                                store(c, Result);
 
-                simd<T, simd_abi::fixed_size<4>> col(&v.x, element_aligned);
-                for (int i = 0; i < 4; i++) {
-                        T row_data[] = { m[0][i], m[1][i], m[2][i], m[3][i] };
-                        simd<T, simd_abi::fixed_size<4>> row;
-                        row.copy_from(row_data, element_aligned);
-                        Result[i] = std::experimental::reduce(row * col);
+                                                return Result;
+                                        }
+                                }
+                        }
+
+                        return make_vec<R, T, P>([&] (size_t r) {
+                                T x = m[0][r] * v[0];
+
+                                for (size_t k = 1; k < C; k++)
+                                        x += m[k][r] * v[k];
+
+                                return x;
+                        });
+                }
+
+                template<size_t N, typename T, qualifier Q, typename F>
+                VRT_FUNC_CONSTEXPR vec<N, T, Q> make_vec(F const& f)
+                {
+                        return [&] <size_t... I> (std::index_sequence<I...>) {
+                                return vec<N, T, Q>(f(I)...);
+                        }(std::make_index_sequence<N>());
                 }
+        }
+
+        // -- struct matrix<C, R, T> --
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR matrix<C, R, T, Q>::matrix(T const& s)
+        {
+                for (size_t c = 0; c < C; c++)
+                        data[c] = detail::make_vec<R, T, Q>([&] (size_t r) { return c == r ? s : T(0); });
+        }
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        template<typename... V>
+        requires (sizeof...(V) == C && (std::is_same_v<V, vec<R, T, Q>> && ...))
+        VRT_FUNC_CONSTEXPR matrix<C, R, T, Q>::matrix(V const&... columns)
+                : data { columns... }
+        {}
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        template<size_t N, qualifier P>
+        VRT_FUNC_CONSTEXPR matrix<C, R, T, Q>::matrix(mat<N, T, P> const& m)
+        {
+                for (size_t c = 0; c < C; c++)
+                        data[c] = detail::make_vec<R, T, Q>([&] (size_t r) { return c < N && r < N ? m[c][r] : T(c == r ? 1 : 0); });
+        }
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        template<size_t N, qualifier P>
+        VRT_FUNC_CONSTEXPR matrix<C, R, T, Q>::operator mat<N, T, P>() const
+        {
+                mat<N, T, P> Result;
+
+                for (size_t c = 0; c < N; c++)
+                        Result[c] = detail::make_vec<N, T, P>([&] (size_t r) { return c < C && r < R ? data[c][r] : T(c == r ? 1 : 0); });
 
                 return Result;
         }
 
-        // -- tools define --
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<R, T, Q>& matrix<C, R, T, Q>::operator[](size_t n)
+        {
+                VRT_CHECK_INDEX(n, C);
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<2, T> &v);
+                return data[n];
+        }
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<3, T> &v);
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<R, T, Q> const& matrix<C, R, T, Q>::operator[](size_t n) const
+        {
+                VRT_CHECK_INDEX(n, C);
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<4, T> &v);
+                return data[n];
+        }
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR matrix<C, R, T, Q> operator*(matrix<C, R, T, Q> const& m, T const& v)
+        {
+                matrix<C, R, T, Q> Result;
+
+                for (size_t i = 0; i < C; i++)
+                        Result[i] = m[i] * v;
+
+                return Result;
+        }
+
+        template<size_t C, size_t R, size_t K, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR detail::mat_t<K, R, T, Q> operator*(matrix<C, R, T, Q> const& m1, matrix<K, C, T, Q> const& m2)
+        {
+                detail::mat_t<K, R, T, Q> Result;
+                detail::mul_columns<C, K, R, T, Q>(m1, m2, Result);
+
+                return Result;
+        }
 
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR matrix<C, R, T, Q> operator*(matrix<C, R, T, Q> const& m1, mat<C, T, Q> const& m2)
+        {
+                matrix<C, R, T, Q> Result;
+                detail::mul_columns<C, C, R, T, Q>(m1, m2, Result);
+
+                return Result;
+        }
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR matrix<C, R, T, Q> operator*(mat<R, T, Q> const& m1, matrix<C, R, T, Q> const& m2)
+        {
+                matrix<C, R, T, Q> Result;
+                detail::mul_columns<R, C, R, T, Q>(m1, m2, Result);
+
+                return Result;
+        }
+
+        template<size_t R, typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<R, T, P> operator*(matrix<2, R, T, Q> const& m, vec<2, T, P> const& v)
+        {
+                return detail::mul_vector(m, v);
+        }
+
+        template<size_t R, typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<R, T, P> operator*(matrix<3, R, T, Q> const& m, vec<3, T, P> const& v)
+        {
+                return detail::mul_vector(m, v);
+        }
+
+        template<size_t R, typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<R, T, P> operator*(matrix<4, R, T, Q> const& m, vec<4, T, P> const& v)
+        {
+                return detail::mul_vector(m, v);
+        }
+
+        // -- aligned allocator --
+
+        ///
+        /// @brief 按固定字节对齐分配内存的分配器，默认按缓存行（64 字节）对齐。
+        ///
+        /// 用于在 std::vector 等容器中存放 aligned16 / aligned32 的 vec 与 mat，
+        /// 保证容器首地址与缓存行对齐，元素可以直接使用对齐加载。
+        ///
+        /// @tparam T 元素类型
+        /// @tparam Alignment 对齐字节数（2 的幂），实际对齐取 Alignment 与 alignof(T) 的较大值
+        ///
+        template<typename T, size_t Alignment = 64>
+        struct aligned_allocator {
+                static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+
+                typedef T value_type;
+
+                static constexpr size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+                template<typename U>
+                struct rebind { typedef aligned_allocator<U, Alignment> other; };
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR aligned_allocator() noexcept VRT_FUNC_DEFAULT_CTOR;
+
+                template<typename U>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR aligned_allocator(aligned_allocator<U, Alignment> const&) noexcept {}
+
+                VRT_FUNC_DECL T* allocate(size_t n)
+                {
+                        if (n > static_cast<size_t>(-1) / sizeof(T))
+                                throw std::bad_array_new_length();
+
+                        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+                }
+
+                VRT_FUNC_DECL void deallocate(T* p, size_t) noexcept
+                {
+                        ::operator delete(p, std::align_val_t(alignment));
+                }
+        };
+
+        template<typename T, typename U, size_t Alignment>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool operator==(aligned_allocator<T, Alignment> const&, aligned_allocator<U, Alignment> const&) noexcept
+        {
+                return true;
+        }
+
+        template<typename T, typename U, size_t Alignment>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool operator!=(aligned_allocator<T, Alignment> const&, aligned_allocator<U, Alignment> const&) noexcept
+        {
+                return false;
+        }
+
+        ///
+        /// @brief 使用缓存行对齐分配器的 std::vector，例如 aligned_vector<mat4a>。
+        ///
         template<typename T>
-        VRT_FUNC_DECL VRT_INLINE T* value_ptr(mat<4, T> &v);
+        using aligned_vector = std::vector<T, aligned_allocator<T>>;
+
+        // -- tools define --
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<2, T, Q> &v);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<3, T, Q> &v);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<4, T, Q> &v);
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(mat<4, T, Q> &m);
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(matrix<C, R, T, Q> &m);
 
         template<typename T>
         VRT_FUNC_DECL VRT_INLINE bool equals(T const* m1, T const* m2);
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool equals(vec<N, T, Q> const& v1, vec<N, T, Q> const& v2);
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool equals(mat<N, T, Q> const& m1, mat<N, T, Q> const& m2);
         
         // -- tools implements --
         
-        template<typename T>
-        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<2, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<2, T, Q> &v)
         {
-                return &(v.x);
+                return v.data;
         }
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<3, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<3, T, Q> &v)
         {
-                return &(v.x);
+                return v.data;
         }
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<4, T> &v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(vec<4, T, Q> &v)
         {
-                return &(v.x);
+                return v.data;
         }
 
-        template<typename T>
-        VRT_FUNC_DECL VRT_INLINE T* value_ptr(mat<4, T> &m)
+        template<typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(mat<4, T, Q> &m)
+        {
+                return m[0].data;
+        }
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE T* value_ptr(matrix<C, R, T, Q> &m)
         {
-                return &(m[0].x);
+                return m[0].data;
         }
 
         template<typename T>
         VRT_FUNC_DECL VRT_INLINE bool equals(T const* m1, T const* m2)
         {
+                bool Result = true;
+
                 for (int i = 0; i < 16; i++)
-                        if (m1[i] != m2[i])
-                                return false;
+                        Result &= m1[i] == m2[i];
 
-                return true;
+                return Result;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool equals(vec<N, T, Q> const& v1, vec<N, T, Q> const& v2)
+        {
+                bool Result = true;
+
+                for (size_t i = 0; i < N; i++)
+                        Result &= v1[i] == v2[i];
+
+                return Result;
+        }
+
+        template<size_t N, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool equals(mat<N, T, Q> const& m1, mat<N, T, Q> const& m2)
+        {
+                bool Result = true;
+
+                for (size_t i = 0; i < N; i++)
+                        Result &= equals(m1[i], m2[i]);
+
+                return Result;
+        }
+
+        template<size_t W, size_t N, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE vec<N, packet<T, W>> gather(vec<N, T, Q> const* src)
+        {
+                vec<N, packet<T, W>> Result;
+
+                for (size_t i = 0; i < N; i++)
+                        Result.data[i] = packet<T, W>([&](auto j) { return src[j].data[i]; });
+
+                return Result;
+        }
+
+        template<size_t N, typename T, typename Abi, qualifier Q>
+        VRT_FUNC_DECL VRT_INLINE void scatter(vec<N, std::experimental::simd<T, Abi>> const& p, vec<N, T, Q>* dst)
+        {
+                for (size_t j = 0; j < std::experimental::simd_size_v<T, Abi>; j++)
+                        for (size_t i = 0; i < N; i++)
+                                dst[j].data[i] = p.data[i][j];
         }
 
 }
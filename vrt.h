@@ -20,13 +20,30 @@
 
 #include "vec.h"
 // std
+#include <bit>
+#include <concepts>
+#include <cstdint>
 #include <cstdio>
 #include <cmath>
 #include <stdexcept>
+#include <limits>
+#include <type_traits>
+#if defined(__SSE__)
+#  include <immintrin.h>
+#endif
 
 #define VRT_INT32   int
 #define VRT_FLOAT32 float
 
+///
+/// 标量函数、向量与矩阵运算都可以在常量表达式中求值：
+///
+///     constexpr mat4 view = translate(rotate(mat4(1.0f), 30.0f, vec3(0, 1, 0)), vec3(0, 0, -5));
+///
+/// 运行时仍走 simd / std 的实现；常量求值时（if consteval）simd 路径改为逐分量计算，
+/// sin / cos / float 反三角函数使用与运行时相同的多项式，其余调用 std 的函数改用 detail 中的
+/// long double 级数实现（ce_*），结果与运行时最多相差 1 ulp。
+///
 namespace vrt {
         // -- define --
 
@@ -72,29 +89,174 @@ namespace vrt {
         VRT_FUNC_DECL VRT_FUNC_CONSTEXPR abs(T x);
 
         ///
-        /// @brief 计算浮点数 `x` 的整数次幂。
+        /// @brief 计算浮点数 `x` 的 `a` 次幂。
         ///
-        /// pow 函数用于计算浮点数 `x` 的 `a` 次幂，其中 `a` 是一个整数。
-        /// 该函数通过连续乘法实现幂运算，适用于需要高效计算整数次幂的场景。
+        /// pow 函数用于计算浮点数 `x` 的 `a` 次幂，`a` 可以是任意实数。
+        /// float packet（以及 float 向量）不调用 std::pow，而是按 pow(x, a) = exp2(a * log2(x)) 逐通道并行计算：
+        /// log2(x) 拆分为整数指数与尾数部分，a 拆分为高低两段，使 a 与整数指数的乘积精确，误差主要来自尾数部分的对数。
+        /// 标量调用 std::pow：标准库的标量实现基于查表，实测比多项式更快。
         ///
         /// 计算公式如下：
         ///   pow(x, a) = x^a
         ///
-        /// @param x 底数（浮点数）
-        /// @param a 指数（整数）
-        /// @return float 返回 `x` 的 `a` 次幂结果。
+        /// 误差范围：float packet 在结果为正规数时约为 (1.5 + 0.4 * |a|) ulp，|a| ≤ 4 时最大 2.5 ulp；
+        /// double packet 逐通道调用 std::pow。
+        ///
+        /// 指数为整数时应使用 pow<N>(x)（编译期展开）或 pow(x, n)（运行时整数次幂），只需乘法。
+        ///
+        /// @param x 底数（浮点数或 packet）
+        /// @param a 指数（浮点数或 packet）
+        /// @return T 返回 `x` 的 `a` 次幂结果。
         ///
         /// @note pow 的常见用途：
         ///  1. 计算几何增长或衰减，如复利计算、物理中的指数衰减等。
         ///  2. 在图形学中计算光照衰减、颜色混合等。
         ///  3. 在数学运算中，快速计算幂次结果。
         ///
-        /// @warning 当 `x` 为负数且 `a` 为非整数时，结果可能为 NaN（未定义）。
-        ///          当 `x` 为 0 且 `a` 为负数时，结果可能为无穷大（inf）。
+        /// @warning 与 GLSL 的 pow 相同，float packet 在 `x` 为负数时返回 NaN（负底数请使用整数次幂）；
+        ///          `x` 为 0 时按 `a` 的符号返回 0、1 或 inf；`a` 为 ±inf 时返回 NaN。
         ///
         template<typename T = VRT_FLOAT32>
         VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T pow(T x, T a);
 
+        ///
+        /// @brief 计算编译期整数次幂 x^N。
+        ///
+        /// 在编译期按二进制平方展开为 O(log N) 次乘法，例如 pow<5>(x) 展开为 (x²)² * x；
+        /// N 为负数时返回 1 / x^-N。T 可以是标量、packet 或向量（逐分量相乘）。
+        ///
+        /// @tparam N 指数
+        /// @param x 底数
+        /// @return T 返回 x^N
+        ///
+        template<int N, typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T pow(T x);
+
+        ///
+        /// @brief 计算运行时整数次幂 x^n。
+        ///
+        /// 按 n 的二进制位做平方-乘法，循环 log2(|n|) 次，n 为负数时返回 1 / x^-n；
+        /// 负底数按 n 的奇偶得到正确的符号。T 可以是标量、packet 或向量（逐分量相乘）。
+        ///
+        /// @param x 底数
+        /// @param n 指数（整数）
+        /// @return T 返回 x^n
+        ///
+        template<typename T = VRT_FLOAT32, std::integral I = VRT_INT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T pow(T x, I n);
+
+        ///
+        /// @brief 逐分量计算向量的幂。
+        ///
+        /// 标量分量的向量整体加载为 simd 后计算，packet 分量的向量逐分量计算，两者都使用 packet 版本的实现与误差范围。
+        ///
+        /// @param v 底数向量
+        /// @param a 指数向量，或所有分量共用的指数
+        /// @return vec<L, T> 返回逐分量的结果
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> pow(vec<L, T, Q> const& v, vec<L, T, Q> const& a);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> pow(vec<L, T, Q> const& v, T a);
+
+        ///
+        /// @brief 计算自然指数 e^x。
+        ///
+        /// float packet 按 ln2 做 Cody-Waite 两段式范围缩减 x = n * ln2 + r（|r| ≤ ln2 / 2），在 r 上计算多项式
+        /// （Cephes 系数），再通过指数位构造 2^n 缩放；标量调用 std::exp（原因同 pow()）。
+        ///
+        /// @param x 输入值（浮点数或 packet）
+        /// @return T 返回 e^x；上溢时返回 inf，下溢时逐渐变为非正规数直至 0
+        ///
+        /// @note float packet 最大误差 1.5 ulp；double packet 逐通道调用 std::exp。
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T exp(T x);
+
+        ///
+        /// @brief 计算以 2 为底的指数 2^x。
+        ///
+        /// float packet 拆分 x = n + f（|f| ≤ 0.5），2^f 使用多项式，2^n 直接构造指数位；标量调用 std::exp2。
+        ///
+        /// @param x 输入值（浮点数或 packet）
+        /// @return T 返回 2^x
+        ///
+        /// @note float packet 最大误差 2 ulp；double packet 逐通道调用 std::exp2。
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T exp2(T x);
+
+        ///
+        /// @brief 计算自然对数 ln(x)。
+        ///
+        /// float packet 从浮点位中取出指数 e 与尾数 m ∈ [√½, √2)，ln(x) = e * ln2 + ln(m)，ln(m) 使用多项式
+        /// （Cephes 系数），非正规数先放大 2^23 再拆分；标量调用 std::log。
+        ///
+        /// @param x 输入值（浮点数或 packet）
+        /// @return T 返回 ln(x)；x 为 0 时返回 -inf，x 为负数时返回 NaN
+        ///
+        /// @note float packet 最大误差 1 ulp；double packet 逐通道调用 std::log。
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T log(T x);
+
+        ///
+        /// @brief 计算以 2 为底的对数 log2(x)。
+        ///
+        /// 拆分方式同 log()，log2(x) = e + ln(m) * log2(e)。
+        ///
+        /// @param x 输入值（浮点数或 packet）
+        /// @return T 返回 log2(x)；x 为 0 时返回 -inf，x 为负数时返回 NaN
+        ///
+        /// @note float packet 最大误差 1.5 ulp；double packet 逐通道调用 std::log2。
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T log2(T x);
+
+        ///
+        /// @brief 逐分量计算向量的 e^x、2^x、ln(x)、log2(x)。
+        ///
+        /// 标量分量的向量整体加载为 simd 后计算，packet 分量的向量逐分量计算，两者都使用 packet 版本的实现与误差范围。
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> exp(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> exp2(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> log(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> log2(vec<L, T, Q> const& v);
+
+        ///
+        /// @brief packet<float> / packet<double> 的非模板重载。
+        ///
+        /// packet 即 std::experimental::simd，以非限定名调用时实参依赖查找会同时找到 std::experimental 中的同名模板：
+        /// using namespace vrt 下 pow(packet, packet) 有歧义，sin(packet) 等则静默选择 std::experimental 的实现。
+        /// 非模板函数在重载决议中优先于模板，因此默认宽度的 packet 以非限定名调用时也使用 vrt 的实现；
+        /// 指定了其他宽度的 packet<T, W> 仍会选中 std::experimental，需写成 vrt::sin(x) 等限定形式。
+        ///
+        VRT_FUNC_DECL VRT_INLINE packet<float> sin(packet<float> x);
+        VRT_FUNC_DECL VRT_INLINE packet<float> cos(packet<float> x);
+        VRT_FUNC_DECL VRT_INLINE packet<float> tan(packet<float> x);
+        VRT_FUNC_DECL VRT_INLINE packet<float> exp(packet<float> x);
+        VRT_FUNC_DECL VRT_INLINE packet<float> exp2(packet<float> x);
+        VRT_FUNC_DECL VRT_INLINE packet<float> log(packet<float> x);
+        VRT_FUNC_DECL VRT_INLINE packet<float> log2(packet<float> x);
+        VRT_FUNC_DECL VRT_INLINE packet<float> pow(packet<float> x, packet<float> a);
+
+        VRT_FUNC_DECL VRT_INLINE packet<double> sin(packet<double> x);
+        VRT_FUNC_DECL VRT_INLINE packet<double> cos(packet<double> x);
+        VRT_FUNC_DECL VRT_INLINE packet<double> tan(packet<double> x);
+        VRT_FUNC_DECL VRT_INLINE packet<double> exp(packet<double> x);
+        VRT_FUNC_DECL VRT_INLINE packet<double> exp2(packet<double> x);
+        VRT_FUNC_DECL VRT_INLINE packet<double> log(packet<double> x);
+        VRT_FUNC_DECL VRT_INLINE packet<double> log2(packet<double> x);
+        VRT_FUNC_DECL VRT_INLINE packet<double> pow(packet<double> x, packet<double> a);
+
         ///
         /// @brief 将弧度值转换为角度值。
         ///
@@ -141,7 +303,18 @@ namespace vrt {
         /// sin 函数用于计算给定浮点数 `x`（以弧度为单位）的正弦值。
         /// 正弦函数是三角函数之一，常用于描述周期性现象，如波形、振动等。
         ///
-        /// @param x 输入的弧度值（浮点数）
+        /// 不调用 std::sin，而是先按 π/2 做 Cody-Waite 三段式范围缩减，再在 [-π/4, π/4] 上计算
+        /// 多项式（Cephes 系数），象限选择使用掩码混合而非分支，因此同一份代码可以用于标量与 packet。
+        ///
+        /// 误差范围（与正确舍入结果相比）：
+        ///  - float：|x| ≤ 8192 时最大 2.5 ulp
+        ///  - double：|x| ≤ 2^20 时最大 2 ulp
+        ///  - 超出上述范围时多段拆分不再精确，这些参数（packet 为这些通道）改为调用 std::sin / std::cos，
+        ///    结果与 std 相同；常量求值时改用 long double 的三段范围缩减与级数，|x| < 6.7e9 时与运行时
+        ///    最多相差 1 ulp，更大的参数结果仍在 [-1, 1] 内，但缩减误差随 |x| 增大，不保证与 std 一致
+        ///  - NaN 与 ±inf 返回 NaN（常量求值时同样）
+        ///
+        /// @param x 输入的弧度值（浮点数或 packet）
         /// @return float 返回 `x` 的正弦值，范围在 [-1, 1] 之间。
         ///
         /// @note sin 的常见用途：
@@ -149,6 +322,8 @@ namespace vrt {
         ///  2. 在物理仿真中模拟周期性运动，如弹簧振动。
         ///  3. 在信号处理中分析周期性信号。
         ///
+        /// @see sincos()
+        ///
         template<typename T = VRT_FLOAT32>
         VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T sin(T x);
 
@@ -158,7 +333,9 @@ namespace vrt {
         /// cos 函数用于计算给定浮点数 `x`（以弧度为单位）的余弦值。
         /// 余弦函数是三角函数之一，常用于描述周期性现象，如波形、振动等。
         ///
-        /// @param x 输入的弧度值（浮点数）
+        /// 实现与误差范围同 sin()。
+        ///
+        /// @param x 输入的弧度值（浮点数或 packet）
         /// @return float 返回 `x` 的余弦值，范围在 [-1, 1] 之间。
         ///
         /// @note cos 的常见用途：
@@ -166,9 +343,75 @@ namespace vrt {
         ///  2. 在物理仿真中模拟周期性运动，如弹簧振动。
         ///  3. 在信号处理中分析周期性信号。
         ///
+        /// @see sincos()
+        ///
         template<typename T = VRT_FLOAT32>
         VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T cos(T x);
 
+        ///
+        /// @brief 同时计算正弦与余弦值。
+        ///
+        /// 两者共用一次范围缩减和同一组多项式，开销与单独调用 sin() 相同，误差范围同 sin()。
+        ///
+        /// @param x 输入的弧度值（浮点数或 packet）
+        /// @param s 输出 sin(x)
+        /// @param c 输出 cos(x)
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void sincos(T x, T& s, T& c);
+
+        ///
+        /// @brief 计算浮点数的正切值。
+        ///
+        /// 以 sincos() 的结果计算 sin(x) / cos(x)。
+        ///
+        /// 误差范围：float 在 |x| ≤ 8192 时最大 4 ulp；double 在 |x| ≤ 2^20 时最大 4 ulp。
+        /// x 接近 π/2 + kπ 时结果的绝对值很大，相对误差仍在上述范围内。
+        ///
+        /// @param x 输入的弧度值（浮点数或 packet）
+        /// @return T 返回 `x` 的正切值
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T tan(T x);
+
+        ///
+        /// @brief 逐分量计算向量的正弦、余弦、正切值。
+        ///
+        /// 标量分量的向量整体加载为 simd 后计算，packet 分量的向量逐分量计算，误差范围同标量版本。
+        ///
+        /// @param v 输入的弧度值向量
+        /// @return vec<L, T> 返回逐分量的结果
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> sin(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> cos(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> tan(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void sincos(vec<L, T, Q> const& v, vec<L, T, Q>& s, vec<L, T, Q>& c);
+
+        ///
+        /// @brief 查表计算整数角度的正弦与余弦值。
+        ///
+        /// 角度先归约到 [0, 360)，再从编译期生成的 360 项表中读取，不调用任何超越函数。
+        /// 表项由 long double 级数计算后舍入到 T，因此结果是正确舍入的，
+        /// 0、90、180、270 度处的值精确为 0 与 ±1。
+        ///
+        /// @param angdeg 输入的角度值（整数，可以为负或超过 360）
+        /// @param s 输出 sin(angdeg)
+        /// @param c 输出 cos(angdeg)
+        ///
+        /// @note 适用于网格吸附、瓦片朝向、UI 等只使用整数角度的旋转。
+        ///
+        /// @see sincos(), rotate()
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void sincos_deg(int angdeg, T& s, T& c);
+
         ///
         /// @brief 计算反余弦函数值
         ///
@@ -191,8 +434,68 @@ namespace vrt {
         ///  3. 计算机图形学中的角度计算
         ///  4. 机器人运动学中的关节角度计算
         ///
+        /// @note float（标量与 packet）使用 Cephes 多项式逼近，不调用 std::acos，最大误差 2 ulp；
+        ///       double 逐通道调用 std::acos。
+        ///
         template<typename T = VRT_FLOAT32>
         VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T arccos(T x);
+
+        ///
+        /// @brief 计算反正弦函数值。
+        ///
+        /// |x| ≤ 0.5 时直接计算多项式，|x| > 0.5 时使用 asin(x) = π/2 - 2 * asin(sqrt((1 - |x|) / 2))，
+        /// 两条路径以掩码混合，标量与 packet 共用同一份代码。
+        ///
+        /// @param x 输入值，范围必须在 [-1.0, 1.0] 之间
+        /// @return T 返回对应的弧度值，范围 [-π/2, π/2]
+        ///
+        /// @note float（标量与 packet）最大误差 3 ulp；double 逐通道调用 std::asin。
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T arcsin(T x);
+
+        ///
+        /// @brief 计算反正切函数值。
+        ///
+        /// 先将 |x| 缩减到 [0, tan(π/8)]（|x| > tan(3π/8) 时使用 -1/x，|x| > tan(π/8) 时使用 (x-1)/(x+1)），
+        /// 再计算多项式。
+        ///
+        /// @param x 输入值
+        /// @return T 返回对应的弧度值，范围 [-π/2, π/2]
+        ///
+        /// @note float（标量与 packet）最大误差 3 ulp；double 逐通道调用 std::atan。
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T arctan(T x);
+
+        ///
+        /// @brief 计算 y / x 的反正切值，根据 x、y 的符号确定象限。
+        ///
+        /// @param y 纵坐标
+        /// @param x 横坐标
+        /// @return T 返回点 (x, y) 与 x 轴正方向的夹角，范围 [-π, π]；x、y 同时为 0 时返回 0
+        ///
+        /// @note float（标量与 packet）最大误差 3.5 ulp；double 逐通道调用 std::atan2。
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T arctan2(T y, T x);
+
+        ///
+        /// @brief 逐分量计算向量的反余弦、反正弦、反正切值。
+        ///
+        /// 标量分量的向量整体加载为 simd 后计算，packet 分量的向量逐分量计算，误差范围同标量版本。
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> arccos(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> arcsin(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> arctan(vec<L, T, Q> const& v);
+
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> arctan2(vec<L, T, Q> const& y, vec<L, T, Q> const& x);
         
         ///
         /// @brief 计算浮点数的平方根。
@@ -219,7 +522,7 @@ namespace vrt {
         /// 平方根是数学中的基本运算，常用于几何、物理和工程计算中。
         ///
         /// @param v 输入的浮点数向量（必须为非负数）
-        /// @return vec<4, T> 返回 `v` 向量的平方根，结果为非负数。
+        /// @return vec<2, T> 返回 `v` 向量的平方根，结果为非负数。
         ///
         /// @note sqrt 的常见用途：
         ///  1. 计算几何中的距离或长度，如欧几里得距离。
@@ -227,8 +530,8 @@ namespace vrt {
         ///
         /// @warning 当 `x` 为负数时，结果可能为 NaN（未定义）。
         ///
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T> sqrt(vec<4, T> const& v);
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<2, T, Q> sqrt(vec<2, T, Q> const& v);
 
         ///
         /// @brief 计算 3个浮点数的平方根。
@@ -237,16 +540,18 @@ namespace vrt {
         /// 平方根是数学中的基本运算，常用于几何、物理和工程计算中。
         ///
         /// @param v 输入的浮点数向量（必须为非负数）
-        /// @return vec<4, T> 返回 `v` 向量的平方根，结果为非负数。
+        /// @return vec<3, T> 返回 `v` 向量的平方根，结果为非负数。
         ///
         /// @note sqrt 的常见用途：
         ///  1. 计算几何中的距离或长度，如欧几里得距离。
         ///  2. 在物理中计算速度、加速度等。
         ///
+        /// @note 对于 padded 布局（vec3a），使用 4 通道对齐加载与存储；packed 布局只读取 3 个分量。
+        ///
         /// @warning 当 `x` 为负数时，结果可能为 NaN（未定义）。
         ///
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T> sqrt(vec<4, T> const& v);
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> sqrt(vec<3, T, Q> const& v);
         
         ///
         /// @brief 计算 4个 浮点数的平方根。
@@ -263,68 +568,36 @@ namespace vrt {
         ///
         /// @warning 当 `x` 为负数时，结果可能为 NaN（未定义）。
         ///
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T> sqrt(vec<4, T> const& v);
-
-        ///
-        /// @brief 计算二维向量的规约和
-        ///
-        /// 对二维向量的所有分量进行求和操作，返回标量结果。
-        /// 对于向量 v = (x,y)，计算结果为 x + y。
-        ///
-        /// @tparam T 向量元素类型（默认为 VRT_FLOAT32）
-        /// @param v 输入向量
-        /// @return T 返回向量各分量的总和
-        ///
-        /// @note 典型应用场景：
-        ///  1. 计算向量分量总和
-        ///  2. 简化向量运算
-        ///  3. 作为更复杂运算的中间步骤
-        ///
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T reduce(vec<2, T> const& v);
-
-        ///
-        /// @brief 计算三维向量的规约和 
-        ///
-        /// 对三维向量的所有分量进行求和操作，返回标量结果。
-        /// 对于向量 v = (x,y,z)，计算结果为 x + y + z。
-        ///
-        /// @tparam T 向量元素类型（默认为 VRT_FLOAT32）
-        /// @param v 输入向量
-        /// @return T 返回向量各分量的总和
-        ///
-        /// @note 典型应用场景：
-        ///  1. 计算空间坐标总和
-        ///  2. 物理模拟中的量值汇总
-        ///  3. 图形学中的简化计算
-        ///
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T reduce(vec<3, T> const& v);
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<4, T, Q> sqrt(vec<4, T, Q> const& v);
 
         ///
-        /// @brief 计算四维向量的规约和
+        /// @brief 计算向量的规约和
         ///
-        /// 对四维向量的所有分量进行求和操作，返回标量结果。
+        /// 对向量的所有分量进行求和操作，返回标量结果。
         /// 对于向量 v = (x,y,z,w)，计算结果为 x + y + z + w。
         ///
+        /// 以 for (i < L) 的形式逐分量累加，下标访问无分支，编译器可以直接向量化；
+        /// L > 4 的宽向量在运行时整体加载为 simd 后做水平规约。
+        ///
         /// @tparam T 向量元素类型（默认为 VRT_FLOAT32）
         /// @param v 输入向量
         /// @return T 返回向量各分量的总和
         ///
         /// @note 典型应用场景：
-        ///  1. 齐次坐标计算
-        ///  2. 高维数据聚合
-        ///  3. 复杂变换的中间计算
+        ///  1. 计算向量分量总和
+        ///  2. 齐次坐标计算
+        ///  3. 作为点积、长度等运算的中间步骤
         ///
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T reduce(vec<4, T> const& v);
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T reduce(vec<L, T, Q> const& v);
 
         ///
         /// @brief 计算向量间的夹角弧度值
         ///
         /// 计算两个向量之间的最小夹角，返回弧度值而非度数。
-        /// 使用点积公式计算：θ = arccos(dot(v1, v2) / (length(v1) * length(v2)))
+        /// 使用点积公式计算：θ = arccos(dot(v1, v2) / sqrt(dot(v1, v1) * dot(v2, v2)))，
+        /// 只计算一次平方根，余弦值截断到 [-1, 1] 以避免舍入误差导致 NaN。
         /// 结果范围为[0, π]弧度
         ///
         /// @tparam T 向量元素类型（默认为VRT_FLOAT32）
@@ -343,13 +616,31 @@ namespace vrt {
         ///  3. 需要弧度值的数学运算
         ///
         /// @warning
-        ///   - 零向量输入将导致未定义行为
-        ///   - 对于边界情况建议先归一化向量
+        ///   - 任一输入为零向量时返回 0
+        ///   - |v1|² * |v2|² 超出 T 的范围时结果无效（float 下约为 |v1| * |v2| > 1e19）
+        ///
+        /// @see degrees(), dot(), length(), normalize(), fast_angle()
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T angle(vec<L, T, Q> const& v1, vec<L, T, Q> const& v2);
+
+        ///
+        /// @brief 快速计算向量间的夹角弧度值，angle() 的近似版本。
+        ///
+        /// 以 inverse_sqrt(dot(v1, v1) * dot(v2, v2)) 代替平方根和除法，余弦值截断到 [-1, 1]。
+        /// 余弦值的相对误差同 inverse_sqrt()，由于 arccos 在 ±1 附近的导数趋于无穷，
+        /// 两向量接近平行或反向时角度误差可达 1e-3 弧度，其余情况约为 1e-6 弧度。
+        ///
+        /// @param v1 第一个输入向量
+        /// @param v2 第二个输入向量
+        /// @return T 两向量间的弧度值，范围[0, π]，任一输入为零向量时返回 0
         ///
-        /// @see degrees(), dot(), length(), normalize()
+        /// @note 适用于法线锥、关节限位等批量阈值判断；T 可以是 packet，一次计算多组夹角。
         ///
-        template<size_t L, typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T angle(vec<L, T> const& v1, vec<L, T> const& v2);
+        /// @see angle(), inverse_sqrt()
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T fast_angle(vec<L, T, Q> const& v1, vec<L, T, Q> const& v2);
 
         ///
         /// @brief 计算两个向量的点积
@@ -373,8 +664,8 @@ namespace vrt {
         ///  3. 判断向量是否正交
         ///  4. 计算向量长度的平方（dot(v,v) = |v|²）
         ///
-        template<size_t L, typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T dot(vec<L, T> const& v1, vec<L, T> const& v2);
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T dot(vec<L, T, Q> const& v1, vec<L, T, Q> const& v2);
 
         /// 
         /// @brief 计算向量的长度（模）。
@@ -393,8 +684,8 @@ namespace vrt {
         ///  2. 在物理仿真中计算速度、力的强度等。
         ///  3. 在游戏开发中计算距离或范围。
         /// 
-        template<size_t L, typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T length(vec<L, T> const& v);
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T length(vec<L, T, Q> const& v);
 
         ///
         /// @brief 归一化向量。
@@ -411,14 +702,141 @@ namespace vrt {
         ///  2. 齐次坐标系的规范化
         ///  3. 投影空间计算
         ///
-        template<size_t L, typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T> normalize(vec<L, T> const& v);
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> normalize(vec<L, T, Q> const& v);
+
+        ///
+        /// @brief 计算两个三维向量的叉积。
+        ///
+        /// 对于 a = (x1,y1,z1) 和 b = (x2,y2,z2)，结果为 (y1*z2 - z1*y2, z1*x2 - x1*z2, x1*y2 - y1*x2)，
+        /// 方向垂直于 a 与 b 所在平面（右手定则），长度等于两向量张成的平行四边形面积。
+        ///
+        /// 实现按存储布局选择：
+        ///  - padded / aligned 的 float vec3：整体加载为一个 SSE 寄存器，计算
+        ///    c = a * b.yzx - a.yzx * b，结果为 c.yzx，共三次通道置换、两次乘法、一次减法
+        ///  - packed vec3：按分量计算，连续处理数组时编译器可以跨元素向量化
+        ///  - packet 分量：按分量计算，每条指令处理 W 组向量
+        ///
+        /// @tparam T 向量元素类型（默认为 VRT_FLOAT32），也可以是 packet，一次计算多组叉积
+        /// @param v1 第一个输入向量
+        /// @param v2 第二个输入向量
+        /// @return vec<3, T> 返回叉积向量
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, Q> cross(vec<3, T, Q> const& v1, vec<3, T, Q> const& v2);
+
+        ///
+        /// @brief 计算标量三重积 dot(a, cross(b, c))。
+        ///
+        /// 结果等于 a、b、c 张成的平行六面体的有向体积，也等于以 a、b、c 为列的 3x3 矩阵的行列式：
+        /// 为正时 a、b、c 构成右手系，为 0 时三者共面。
+        ///
+        /// @param a 第一个向量
+        /// @param b 第二个向量
+        /// @param c 第三个向量
+        /// @return T 返回有向体积
+        ///
+        /// @note 典型应用场景：
+        ///  1. 判断点在平面或三角形的哪一侧
+        ///  2. 四面体体积与网格体积计算
+        ///  3. 射线与三角形相交（Möller-Trumbore）
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T triple(vec<3, T, Q> const& a, vec<3, T, Q> const& b, vec<3, T, Q> const& c);
+
+        ///
+        /// @brief 由单位向量 n 构造正交基 (b1, b2, n)。
+        ///
+        /// 使用 Duff 等人对 Frisvad 方法的改进（"Building an Orthonormal Basis, Revisited", JCGT 2017）：
+        /// 按 n.z 的符号取 s = ±1，a = -1 / (s + n.z)，
+        ///   b1 = (1 + s * n.x² * a, s * n.x * n.y * a, -s * n.x)
+        ///   b2 = (n.x * n.y * a, s + n.y² * a, -n.y)
+        /// 符号通过掩码混合选择，没有分支，分量可以是 packet。b1、b2、n 构成右手系。
+        ///
+        /// @param n 单位法线
+        /// @param b1 输出第一个切线方向
+        /// @param b2 输出第二个切线方向
+        ///
+        /// @note 适用于着色中的切线空间、采样方向变换、碰撞检测中的接触坐标系。
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void orthonormal_basis(vec<3, T, Q> const& n, vec<3, T, Q>& b1, vec<3, T, Q>& b2);
+
+        ///
+        /// @brief 快速计算平方根的倒数 1 / sqrt(x)。
+        ///
+        /// float（标量与 packet）使用硬件倒数平方根估计（rsqrtss / rsqrtps，AVX-512 下为 rsqrt14ps），
+        /// 再做一次牛顿迭代：y = y * (1.5 - 0.5 * x * y * y)。
+        ///
+        /// 误差范围（相对误差）：
+        ///  - SSE / AVX：估计值误差 ≤ 1.5 * 2^-12，迭代后 ≤ 2^-21（约 4 ulp）
+        ///  - AVX-512：估计值误差 ≤ 2^-14，迭代后 ≤ 2^-22（约 2 ulp）
+        ///  - double 及非 x86 目标：直接计算 1 / sqrt(x)，与 sqrt 结果一致
+        ///
+        /// 硬件估计会把非规格化数当作 0，这类输入先放大 2^24 再估计，误差范围不变。
+        /// 特殊值与 1 / sqrt(x) 一致：±0 返回 ±inf，+inf 返回 0，负数与 NaN 返回 NaN。
+        ///
+        /// @tparam T 浮点数类型或 packet
+        /// @param x 输入值
+        /// @return T 返回 1 / sqrt(x) 的近似值
+        ///
+        /// @warning -ffast-math（-ffinite-math-only）下编译器假定没有 inf / NaN，0 与 inf 的结果不再保证。
+        ///
+        template<typename T = VRT_FLOAT32>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T inverse_sqrt(T x);
+
+        ///
+        /// @brief 计算向量长度的倒数 1 / length(v)。
+        ///
+        /// 以 inverse_sqrt(dot(v, v)) 实现，省去一次 sqrt 和一次除法，误差范围同 inverse_sqrt()。
+        ///
+        /// @param v 输入向量（不能为零向量）
+        /// @return T 返回向量长度的倒数
+        ///
+        /// @see inverse_sqrt(), fast_length(), fast_normalize()
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T inverse_length(vec<L, T, Q> const& v);
+
+        ///
+        /// @brief 快速计算向量的长度，length(v) 的近似版本。
+        ///
+        /// 计算 dot(v, v) * inverse_sqrt(dot(v, v))，误差范围同 inverse_sqrt()。
+        ///
+        /// @param v 输入向量（不能为零向量）
+        /// @return T 返回向量长度的近似值
+        ///
+        /// @see length(), inverse_length()
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T fast_length(vec<L, T, Q> const& v);
+
+        ///
+        /// @brief 归一化向量，normalize(v) 的近似版本（对应 glm::fastNormalize）。
+        ///
+        /// 计算 v * inverse_length(v)：用一次倒数平方根估计和 N 次乘法代替 sqrt 与 N 次除法，
+        /// 结果向量长度与 1 的相对误差不超过 inverse_sqrt() 的误差范围。
+        ///
+        /// @param v 输入向量（不能为零向量）
+        /// @return vec<L, T> 返回近似的单位向量
+        ///
+        /// @note 现代 x86 上 sqrtps / divps 的吞吐已与估计加牛顿迭代相当，main.cpp 基准中标量 vec3
+        ///       与 vec3_packet 两种布局下本函数都不比 normalize() 快。批量归一化的收益来自 SoA 布局：
+        ///       normalize(vec3_packet) 约为逐个 normalize(vec3) 的 3 倍吞吐。
+        ///
+        /// @see normalize(), inverse_length()
+        ///
+        template<size_t L, typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<L, T, Q> fast_normalize(vec<L, T, Q> const& v);
 
         ///
         /// @brief 创建平移变换矩阵。
         ///
         /// 在现有4x4变换矩阵 `m` 基础上，应用由三维向量 `v` 指定的平移变换。
-        /// 返回新的变换矩阵，保持原矩阵的其他变换不变。
+        /// 返回新的变换矩阵 m * T，保持原矩阵的其他变换不变。
+        ///
+        /// T 只有第 3 列非单位列，因此只计算结果的第 3 列（m[0] * x + m[1] * y + m[2] * z + m[3]），
+        /// 其余三列直接复制，不做完整的矩阵乘法。
         ///
         /// @tparam T 浮点数类型，默认为 VRT_FLOAT32
         /// @param m 输入的4x4变换矩阵
@@ -430,17 +848,59 @@ namespace vrt {
         ///  2. 相机视图矩阵构造
         ///  3. 场景图节点变换
         ///
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T> translate(mat<4, T> const& m, vec<3, T> const& v);
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> translate(mat<4, T, Q> const& m, vec<3, T, P> const& v);
 
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T> rotate(mat<4, T> const& m, T angle, vec<3, T> const& v);
+        ///
+        /// @brief 创建旋转变换矩阵。
+        ///
+        /// 在现有4x4变换矩阵 `m` 基础上，应用绕轴 `v` 逆时针旋转 `angle` 度的变换（右手坐标系），
+        /// 返回 m * R。R 只有左上 3x3 非单位，结果只计算前三列，第 3 列直接复制。
+        ///
+        /// @param m 输入的4x4变换矩阵
+        /// @param angle 旋转角度（度）
+        /// @param v 旋转轴（不需要是单位向量，但不能为零向量）
+        /// @return mat<4, T> 返回应用旋转后的新变换矩阵
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate(mat<4, T, Q> const& m, T angle, vec<3, T, P> const& v);
+
+        ///
+        /// @brief 创建整数角度的旋转变换矩阵。
+        ///
+        /// 与浮点角度版本相同，但 sin / cos 通过 sincos_deg() 查表得到，不调用超越函数。
+        ///
+        /// @see sincos_deg(), rotate_x_deg(), rotate_y_deg(), rotate_z_deg()
+        ///
+        template<typename T = VRT_FLOAT32, std::integral I = VRT_INT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate(mat<4, T, Q> const& m, I angle, vec<3, T, P> const& v);
+
+        ///
+        /// @brief 创建绕 x / y / z 轴旋转整数角度的旋转矩阵。
+        ///
+        /// 等价于 rotate(mat4(1), angdeg, 轴)，但只写入非零元素，sin / cos 通过 sincos_deg() 查表得到。
+        ///
+        /// @param angdeg 旋转角度（整数度）
+        /// @return mat<4, T> 返回旋转矩阵
+        ///
+        /// @see sincos_deg(), rotate()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate_x_deg(int angdeg);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate_y_deg(int angdeg);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate_z_deg(int angdeg);
         
         ///
         /// @brief 创建缩放变换矩阵。
         ///
         /// 在现有4x4变换矩阵 `m` 基础上，应用由三维向量 `v` 指定的缩放变换。
-        /// 返回新的变换矩阵，保持原矩阵的其他变换不变。
+        /// 返回新的变换矩阵 m * S，保持原矩阵的其他变换不变。
+        ///
+        /// S 为对角矩阵，因此只将 m 的前三列分别乘以 x、y、z，不做完整的矩阵乘法。
         ///
         /// @tparam T 浮点数类型，默认为 VRT_FLOAT32
         /// @param m 输入的4x4变换矩阵
@@ -452,195 +912,2440 @@ namespace vrt {
         ///  2. 非均匀缩放效果实现
         ///  3. 模型空间变换
         ///
-        template<typename T = VRT_FLOAT32>
-        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T> scale(mat<4, T> const& m, vec<3, T> const& v);
-
-        // -- implements --
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> scale(mat<4, T, Q> const& m, vec<3, T, P> const& v);
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR int mod(T x, T y) {
-                if (y == 0)
-                        return 0;
-                return x - ((int) (x / y)) * y;
-        }
+        ///
+        /// @brief 原地应用平移、缩放、旋转：m = m * T / m * S / m * R。
+        ///
+        /// 与 translate()、scale()、rotate() 的结果相同，但直接修改 m，不复制未受影响的列。
+        /// 逐级构建场景图节点的变换时，每一步只需约 12（平移、缩放）或 36（旋转）次乘加。
+        ///
+        /// @param m 被修改的4x4变换矩阵
+        /// @param v 平移向量、缩放向量或旋转轴
+        /// @param angle 旋转角度（度），整数角度使用 sincos_deg() 查表
+        /// @return mat<4, T>& 返回 m
+        ///
+        /// @see translate(), scale(), rotate(), pre_translate()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>& translate_inplace(mat<4, T, Q>& m, vec<3, T, P> const& v);
 
-        template<typename T>
-        T
-        VRT_FUNC_CONSTEXPR abs(T x) {
-                return x < 0 ? -x : x;
-        }
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>& scale_inplace(mat<4, T, Q>& m, vec<3, T, P> const& v);
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T pow(T x, T a) {
-                return std::pow(x, a);
-        }
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>& rotate_inplace(mat<4, T, Q>& m, T angle, vec<3, T, P> const& v);
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR int degrees(T angrad)
-        {
-                return angrad / (M_PI / 180);
-        }
+        template<typename T = VRT_FLOAT32, std::integral I = VRT_INT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>& rotate_inplace(mat<4, T, Q>& m, I angle, vec<3, T, P> const& v);
+
+        ///
+        /// @brief 左乘平移、缩放、旋转：返回 T * m / S * m / R * m。
+        ///
+        /// translate()、scale()、rotate() 在 m 的局部坐标系中应用变换（右乘），
+        /// pre_* 在父坐标系（世界坐标系）中应用变换（左乘）。同样只计算受影响的分量：
+        ///  - pre_translate：每列的 xyz 加上 v * w，仿射矩阵只改变第 3 列
+        ///  - pre_scale：每列的 xyz 逐分量乘以 v
+        ///  - pre_rotate：每列的 xyz 左乘 3x3 旋转，w 不变
+        ///
+        /// @param m 输入的4x4变换矩阵
+        /// @param v 平移向量、缩放向量或旋转轴
+        /// @param angle 旋转角度（度），整数角度使用 sincos_deg() 查表
+        /// @return mat<4, T> 返回变换后的矩阵
+        ///
+        /// @see translate(), scale(), rotate()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> pre_translate(mat<4, T, Q> const& m, vec<3, T, P> const& v);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> pre_scale(mat<4, T, Q> const& m, vec<3, T, P> const& v);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> pre_rotate(mat<4, T, Q> const& m, T angle, vec<3, T, P> const& v);
+
+        template<typename T = VRT_FLOAT32, std::integral I = VRT_INT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> pre_rotate(mat<4, T, Q> const& m, I angle, vec<3, T, P> const& v);
+
+        ///
+        /// @brief 原地左乘平移、缩放、旋转：m = T * m / S * m / R * m。
+        ///
+        /// @return mat<4, T>& 返回 m
+        ///
+        /// @see pre_translate(), pre_scale(), pre_rotate()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>& pre_translate_inplace(mat<4, T, Q>& m, vec<3, T, P> const& v);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>& pre_scale_inplace(mat<4, T, Q>& m, vec<3, T, P> const& v);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>& pre_rotate_inplace(mat<4, T, Q>& m, T angle, vec<3, T, P> const& v);
+
+        template<typename T = VRT_FLOAT32, std::integral I = VRT_INT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q>& pre_rotate_inplace(mat<4, T, Q>& m, I angle, vec<3, T, P> const& v);
+
+        ///
+        /// @brief 使用仿射变换矩阵变换一个点。
+        ///
+        /// 将 `p` 视为齐次坐标 (x, y, z, 1)，按列组合计算 m[0] * x + m[1] * y + m[2] * z + m[3]，
+        /// 不计算 w 分量，也不做透视除法，仅适用于最后一行为 (0, 0, 0, 1) 的仿射矩阵。
+        ///
+        /// @tparam T 浮点数类型，默认为 VRT_FLOAT32
+        /// @param m 仿射变换矩阵
+        /// @param p 需要变换的点
+        /// @return vec<3, T> 返回变换后的点
+        ///
+        /// @note 使用场景：
+        ///  1. 顶点从模型空间变换到世界空间
+        ///  2. 场景图节点位置计算
+        ///
+        /// @see transform_direction()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> transform_point(mat<4, T, Q> const& m, vec<3, T, P> const& p);
+
+        ///
+        /// @brief 使用仿射变换矩阵变换一个方向向量。
+        ///
+        /// 将 `d` 视为齐次坐标 (x, y, z, 0)，计算 m[0] * x + m[1] * y + m[2] * z，
+        /// 平移部分不参与运算，同样不计算 w 分量。
+        ///
+        /// @tparam T 浮点数类型，默认为 VRT_FLOAT32
+        /// @param m 仿射变换矩阵
+        /// @param d 需要变换的方向向量
+        /// @return vec<3, T> 返回变换后的方向向量（未归一化）
+        ///
+        /// @note 使用场景：
+        ///  1. 变换速度、切线等方向量
+        ///  2. 在无非均匀缩放时变换法线
+        ///
+        /// @see transform_point()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed, qualifier P = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR vec<3, T, P> transform_direction(mat<4, T, Q> const& m, vec<3, T, P> const& d);
+
+        ///
+        /// @brief 计算 4x4 矩阵的逆矩阵。
+        ///
+        /// 余子式法：18 个 2x2 子式分成 6 组 4 通道计算并复用，伴随矩阵每一列的 4 个元素形式相同（各 3 次乘加）；
+        /// 行列式为第一列与伴随矩阵第一行的点积，只做一次除法。float 在 SSE 下每组子式与伴随矩阵的每一列
+        /// 各为一个寄存器，以 shuffle 排列通道；double、packet 与常量求值逐元素计算。适用于投影矩阵等一般矩阵，
+        /// 已知为仿射或刚体变换时应使用更便宜的 affine_inverse() / rigid_inverse()。
+        ///
+        /// @tparam T 浮点数类型，默认为 VRT_FLOAT32
+        /// @param m 输入矩阵
+        /// @return mat<4, T> 返回 m 的逆矩阵
+        ///
+        /// @throws std::runtime_error 行列式为 0（不可逆）时抛出
+        ///
+        /// @see affine_inverse(), rigid_inverse()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> inverse(mat<4, T, Q> const& m);
+
+        ///
+        /// @brief 计算仿射变换矩阵（最后一行为 (0, 0, 0, 1)）的逆矩阵。
+        ///
+        /// 左上 3x3 用伴随矩阵求逆（三次叉积与一次除法），平移为 -L⁻¹ * t，
+        /// 计算量约为 inverse() 的一半。最后一行不参与运算，结果的最后一行总是 (0, 0, 0, 1)。
+        ///
+        /// @throws std::runtime_error 左上 3x3 的行列式为 0（不可逆）时抛出
+        ///
+        /// @see inverse(), rigid_inverse()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> affine_inverse(mat<4, T, Q> const& m);
+
+        ///
+        /// @brief 计算刚体变换矩阵（只含旋转与平移）的逆矩阵：旋转部分转置，平移为 -Rᵀ * t。
+        ///
+        /// 不做除法也不检查可逆性。矩阵含缩放或切变时结果错误，此时应使用 affine_inverse()。
+        ///
+        /// @note 使用场景：
+        ///  1. 由相机的世界变换得到观察矩阵
+        ///  2. 骨骼绑定姿势的逆矩阵
+        ///
+        /// @see inverse(), affine_inverse()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> rigid_inverse(mat<4, T, Q> const& m);
+
+        ///
+        /// @brief 矩阵转置。
+        ///
+        /// float 的 4x4 矩阵在 SSE 下整列载入寄存器，以 _MM_TRANSPOSE4_PS 的 8 次 shuffle 完成转置，
+        /// 其他类型与尺寸逐元素交换。
+        ///
+        /// @param m 输入矩阵
+        /// @return mat<N, T> 返回 m 的转置矩阵
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<2, T, Q> transpose(mat<2, T, Q> const& m);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q> transpose(mat<3, T, Q> const& m);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> transpose(mat<4, T, Q> const& m);
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR matrix<R, C, T, Q> transpose(matrix<C, R, T, Q> const& m);
+
+        ///
+        /// @brief 计算矩阵的行列式。
+        ///
+        /// mat3 为三列的混合积 triple(m[0], m[1], m[2])；mat4 先求前两行与后两行各 6 个 2x2 子式，
+        /// 再按 Laplace 展开组合（30 次乘法），不经过 inverse()。
+        ///
+        /// @param m 输入矩阵
+        /// @return T 返回行列式
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T determinant(mat<2, T, Q> const& m);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T determinant(mat<3, T, Q> const& m);
+
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T determinant(mat<4, T, Q> const& m);
+
+        ///
+        /// @brief 计算变换矩阵的法线矩阵：左上 3x3 的逆矩阵的转置。
+        ///
+        /// 逆转置等于余子式矩阵除以行列式，余子式矩阵的三列正好是 cross(m[1], m[2])、cross(m[2], m[0])、
+        /// cross(m[0], m[1])，因此只需三次叉积、一次点积和一次除法，不求逆也不转置。
+        ///
+        /// @param m 变换矩阵
+        /// @return mat<3, T> 返回法线矩阵
+        ///
+        /// @throws std::runtime_error 左上 3x3 的行列式为 0（不可逆）时抛出
+        ///
+        /// @see normal_matrix_uniform()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q> normal_matrix(mat<4, T, Q> const& m);
+
+        ///
+        /// @brief 只含旋转与均匀缩放的变换矩阵的法线矩阵：左上 3x3 除以缩放的平方。
+        ///
+        /// 这类矩阵的左上 3x3 为 s * R，逆转置为 R / s = (s * R) / s²，
+        /// 只需一次点积和一次除法；纯旋转矩阵的结果就是左上 3x3。含非均匀缩放或切变时结果错误，
+        /// 此时应使用 normal_matrix()。
+        ///
+        /// @see normal_matrix()
+        ///
+        template<typename T = VRT_FLOAT32, qualifier Q = packed>
+        VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<3, T, Q> normal_matrix_uniform(mat<4, T, Q> const& m);
+
+        // -- implements --
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR int mod(T x, T y) {
+                if (y == 0)
+                        return 0;
+                return x - ((int) (x / y)) * y;
+        }
+
+        template<typename T>
+        T
+        VRT_FUNC_CONSTEXPR abs(T x) {
+                return x < 0 ? -x : x;
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR int degrees(T angrad)
+        {
+                return angrad / (M_PI / 180);
+        }
 
         template<typename T>
         VRT_FUNC_CONSTEXPR T radians(int angdeg)
         {
-                return angdeg / (180 / M_PI);
+                return angdeg / (180 / M_PI);
+        }
+
+        namespace detail
+        {
+                /* 常量求值使用的 constexpr 实现：std 的数学函数不是 constexpr，simd 也无法在编译期求值。
+                   统一以 long double 计算级数，结果再舍入到目标类型，只在编译期使用，不追求速度 */
+                typedef long double ce_t;
+
+                inline constexpr ce_t ce_pi = 3.14159265358979323846264338327950288L;
+                inline constexpr ce_t ce_ln2 = 0.69314718055994530941723212145817657L;
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool ce_isnan(ce_t x) { return x != x; }
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool ce_isinf(ce_t x) { return x == std::numeric_limits<ce_t>::infinity() || x == -std::numeric_limits<ce_t>::infinity(); }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_sqrt(ce_t x)
+                {
+                        if (ce_isnan(x) || x < 0)
+                                return std::numeric_limits<ce_t>::quiet_NaN();
+
+                        if (x == 0 || ce_isinf(x))
+                                return x;
+
+                        /* 从不小于 sqrt(x) 的初值开始，牛顿迭代单调递减，不再减小时收敛 */
+                        ce_t r = x > 1 ? x : 1;
+
+                        for (;;) {
+                                ce_t n = (r + x / r) / 2;
+
+                                if (n >= r)
+                                        return r;
+
+                                r = n;
+                        }
+                }
+
+                /* 向零取整；|x| ≥ 2^63 时 long double 已是整数，也超出 long long 的范围 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_trunc(ce_t x)
+                {
+                        if (!(x > -0x1p63L && x < 0x1p63L))
+                                return x;
+
+                        return ce_t(static_cast<long long>(x));
+                }
+
+                /* x = m * 2^e，m ∈ [√½, √2)，返回 e */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR int ce_frexp(ce_t& x)
+                {
+                        int e = 0;
+
+                        for (; x >= 2; e++) x /= 2;
+                        for (; x < 1; e--) x *= 2;
+
+                        if (x > 1.41421356237309504880L) {
+                                x /= 2;
+                                e++;
+                        }
+
+                        return e;
+                }
+
+                /* ln(m) = 2 * atanh((m - 1) / (m + 1)) */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_log_mantissa(ce_t m)
+                {
+                        ce_t s = (m - 1) / (m + 1);
+                        ce_t z = s * s;
+                        ce_t t = s;
+                        ce_t Result = 0;
+
+                        for (int k = 1; t != 0 && k < 200; k += 2, t *= z)
+                                Result += t / k;
+
+                        return 2 * Result;
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_log(ce_t x)
+                {
+                        if (ce_isnan(x) || x < 0)
+                                return std::numeric_limits<ce_t>::quiet_NaN();
+
+                        if (x == 0)
+                                return -std::numeric_limits<ce_t>::infinity();
+
+                        if (ce_isinf(x))
+                                return x;
+
+                        int e = ce_frexp(x);
+
+                        return e * ce_ln2 + ce_log_mantissa(x);
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_log2(ce_t x)
+                {
+                        if (ce_isnan(x) || x <= 0 || ce_isinf(x))
+                                return ce_log(x);
+
+                        int e = ce_frexp(x);
+
+                        return e + ce_log_mantissa(x) / ce_ln2;
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_exp(ce_t x)
+                {
+                        if (ce_isnan(x))
+                                return x;
+
+                        if (x > 12000)
+                                return std::numeric_limits<ce_t>::infinity();
+
+                        if (x < -12000)
+                                return 0;
+
+                        /* x = n * ln2 + r，|r| ≤ ln2 / 2，e^r 用泰勒级数 */
+                        long long n = static_cast<long long>(x / ce_ln2 + (x < 0 ? -0.5L : 0.5L));
+                        ce_t r = x - n * ce_ln2;
+                        ce_t t = 1;
+                        ce_t Result = 1;
+
+                        for (int k = 1; k < 40; k++) {
+                                t *= r / k;
+                                Result += t;
+                        }
+
+                        for (; n > 0; n--) Result *= 2;
+                        for (; n < 0; n++) Result /= 2;
+
+                        return Result;
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_exp2(ce_t x)
+                {
+                        return ce_exp(x * ce_ln2);
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_pow(ce_t x, ce_t a)
+                {
+                        /* 整数指数直接做平方-乘法，小整数次幂在编译期是精确的 */
+                        if (a == static_cast<long long>(a) && a >= -1024 && a <= 1024) {
+                                long long n = static_cast<long long>(a);
+                                unsigned long long k = n < 0 ? 0ull - static_cast<unsigned long long>(n) : static_cast<unsigned long long>(n);
+                                ce_t Result = 1;
+
+                                for (ce_t b = x; k != 0; k >>= 1, b *= b)
+                                        if (k & 1)
+                                                Result *= b;
+
+                                if (n < 0)
+                                        return Result == 0 ? std::numeric_limits<ce_t>::infinity() : 1 / Result;
+
+                                return Result;
+                        }
+
+                        if (x == 0)
+                                return a < 0 ? std::numeric_limits<ce_t>::infinity() : 0;
+
+                        return ce_exp(a * ce_log(x));
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_atan(ce_t x)
+                {
+                        if (ce_isnan(x))
+                                return x;
+
+                        if (x < 0)
+                                return -ce_atan(-x);
+
+                        if (x > 1)
+                                return ce_pi / 2 - ce_atan(1 / x);
+
+                        /* atan(x) = 2 * atan(x / (1 + sqrt(1 + x²)))，缩减两次后 |x| ≤ tan(π/16) */
+                        for (int i = 0; i < 2; i++)
+                                x = x / (1 + ce_sqrt(1 + x * x));
+
+                        ce_t z = x * x;
+                        ce_t t = x;
+                        ce_t Result = 0;
+
+                        for (int k = 1; t != 0 && k < 200; k += 2, t *= -z)
+                                Result += t / k;
+
+                        return 4 * Result;
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_atan2(ce_t y, ce_t x)
+                {
+                        if (ce_isnan(x) || ce_isnan(y))
+                                return x + y;
+
+                        if (x > 0)
+                                return ce_atan(y / x);
+
+                        if (x < 0)
+                                return ce_atan(y / x) + (y < 0 ? -ce_pi : ce_pi);
+
+                        return y > 0 ? ce_pi / 2 : (y < 0 ? -ce_pi / 2 : 0);
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_asin(ce_t x)
+                {
+                        if (!(x >= -1 && x <= 1))
+                                return std::numeric_limits<ce_t>::quiet_NaN();
+
+                        return ce_atan2(x, ce_sqrt((1 - x) * (1 + x)));
+                }
+
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_acos(ce_t x)
+                {
+                        if (!(x >= -1 && x <= 1))
+                                return std::numeric_limits<ce_t>::quiet_NaN();
+
+                        return ce_atan2(ce_sqrt((1 - x) * (1 + x)), x);
+                }
+
+                /* |x| ≤ π/2 的泰勒级数 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR ce_t ce_sin(ce_t x)
+                {
+                        ce_t x2 = x * x;
+                        ce_t t = x;
+                        ce_t Result = x;
+
+                        for (int k = 1; t != 0 && Result + t != Result; k++) {
+                                t = -t * x2 / ((2 * k) * (2 * k + 1));
+                                Result += t;
+                        }
+
+                        return Result;
+                }
+
+                /* 任意参数的 sin / cos：π/2 拆为高 32 位 hi、long double 内的余下部分 mid 与 long double 之外的 lo，
+                   三段缩减在 |q| < 2^32（|x| < 6.7e9）时精确；更大的参数每轮缩减把 |r| 缩小约 2^-64，
+                   重复到商为 0，结果有界但误差随 |x| 增大 */
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void ce_sincos(ce_t x, ce_t& s, ce_t& c)
+                {
+                        if (ce_isnan(x) || ce_isinf(x)) {
+                                s = c = std::numeric_limits<ce_t>::quiet_NaN();
+                                return;
+                        }
+
+                        constexpr ce_t hi = ce_trunc(ce_pi / 2 * 0x1p31L) * 0x1p-31L;
+                        constexpr ce_t mid = ce_pi / 2 - hi;
+                        constexpr ce_t lo = -2.50827880633416601177866354016537851e-20L;
+
+                        ce_t r = x;
+                        ce_t m = 0;
+
+                        /* 累计象限 q mod 4，q 很大时 q / 4 仍是整数，余数为 0 */
+                        for (;;) {
+                                ce_t q = ce_trunc(r / (ce_pi / 2) + (r < 0 ? -0.5L : 0.5L));
+
+                                if (q == 0)
+                                        break;
+
+                                r = ((r - q * hi) - q * mid) - q * lo;
+                                m += q - 4 * ce_trunc(q / 4);
+                        }
+
+                        m -= 4 * ce_trunc(m / 4);
+
+                        if (m < 0)
+                                m += 4;
+
+                        /* r ∈ [-π/4, π/4]，cos(r) = 1 - 2 * sin²(r / 2) */
+                        ce_t h = ce_sin(r / 2);
+                        ce_t ps = ce_sin(r);
+                        ce_t pc = 1 - 2 * h * h;
+
+                        if (m == 0) { s = ps;  c = pc;  }
+                        if (m == 1) { s = pc;  c = -ps; }
+                        if (m == 2) { s = -ps; c = -pc; }
+                        if (m == 3) { s = -pc; c = ps;  }
+                }
+
+                /* 整数角度的正弦、余弦表：只用级数计算第一象限的 91 项，其余象限由对称性得到，
+                   因此 sin 与 cos 互相精确对称，0 / 90 / 180 / 270 度处为精确的 0 与 ±1 */
+                template<typename T>
+                struct degree_table {
+                        T s[360];
+                        T c[360];
+                };
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR degree_table<T> make_degree_table()
+                {
+                        T q[91] = {};
+
+                        for (int i = 1; i < 90; i++)
+                                q[i] = T(ce_sin(i * (ce_pi / 180)));
+
+                        q[90] = T(1);
+
+                        degree_table<T> Result = {};
+
+                        for (int i = 0; i < 360; i++) {
+                                int r = i % 90;
+
+                                switch (i / 90) {
+                                        case 0: Result.s[i] =  q[r];      Result.c[i] =  q[90 - r]; break;
+                                        case 1: Result.s[i] =  q[90 - r]; Result.c[i] = -q[r];      break;
+                                        case 2: Result.s[i] = -q[r];      Result.c[i] = -q[90 - r]; break;
+                                        case 3: Result.s[i] = -q[90 - r]; Result.c[i] =  q[r];      break;
+                                }
+                        }
+
+                        return Result;
+                }
+
+                template<typename T>
+                inline constexpr degree_table<T> degree_table_v = make_degree_table<T>();
+        }
+
+        namespace detail
+        {
+                template<typename T, bool = is_packet_v<T>>
+                struct scalar_type { typedef T type; };
+
+                template<typename T>
+                struct scalar_type<T, true> { typedef typename T::value_type type; };
+
+                /* 标量或 packet 的元素类型 */
+                template<typename T>
+                using scalar_t = typename scalar_type<T>::type;
+
+                /* mask ? a : b，packet 使用 where 混合 */
+                template<typename M, typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T select(M const& mask, T const& a, T const& b)
+                {
+                        if constexpr (is_packet_v<T>) {
+                                T Result = b;
+                                where(mask, Result) = a;
+                                return Result;
+                        } else {
+                                return mask ? a : b;
+                        }
+                }
+
+                /* 是否有任一通道为真，用于跳过很少出现的特殊值处理；simd_mask 与 wide 的掩码由 ADL 找到 any_of */
+                template<typename M>
+                VRT_FUNC_DECL VRT_INLINE bool any(M const& mask)
+                {
+                        if constexpr (std::is_same_v<M, bool>)
+                                return mask;
+                        else
+                                return any_of(mask);
+                }
+
+                /* 对编译器隐藏标量 v 的值，阻止 -ffast-math（-fassociative-math）跨越此处重结合加减，例如把 (v + m) - m 化简为 v，
+                   或把多段范围缩减 r - q * p0 - q * p1 合并为 r - q * (p0 + p1)；packet 无法作为 asm 的操作数，原样返回 */
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T fence(T v)
+                {
+                        if constexpr (!is_packet_v<T>) {
+                                if !consteval {
+#if defined(__GNUC__) && defined(__SSE2_MATH__)
+                                        asm("" : "+x"(v));
+#endif
+                                }
+                        }
+
+                        return v;
+                }
+
+                /* 舍入到最近整数（ties to even）。加减 magic = 1.5 * 2^(digits - 1)（|v| < 2^(digits - 2)）在 -ffast-math
+                   （-fassociative-math）下会被化简为 v：
+                    - packet 在 SSE4.1 或 -ffast-math 下使用 rint（roundps；无 SSE4.1 时 libstdc++ 以带屏障的加减实现，
+                      比直接加减多几条指令），否则直接加减；wide 由 ADL 找到自身带屏障的 rint
+                    - 标量在 SSE4.1 下使用 roundss，否则在加减之间插入 fence()
+                    - 常量求值以整数截断后修正 */
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T round_nearest(T v)
+                {
+                        typedef scalar_t<T> S;
+
+                        constexpr S limit = S(1ull << (std::numeric_limits<S>::digits - 1));
+
+                        if constexpr (is_packet_v<T>) {
+#if defined(__SSE4_1__) || defined(__FAST_MATH__)
+                                return rint(v);
+#else
+                                return (v + S(1.5) * limit) - S(1.5) * limit;
+#endif
+                        } else {
+                                if consteval {
+                                        /* |v| ≥ 2^(digits - 1) 时已是整数（NaN 与 inf 原样返回） */
+                                        if (!(v > -limit && v < limit))
+                                                return v;
+
+                                        long long i = static_cast<long long>(v);
+                                        S f = v - S(i);
+
+                                        if (f > S(0.5) || (f == S(0.5) && (i & 1)))
+                                                i++;
+                                        else if (f < S(-0.5) || (f == S(-0.5) && (i & 1)))
+                                                i--;
+
+                                        return S(i);
+                                } else {
+#if defined(__SSE4_1__)
+                                        return std::rint(v);
+#else
+                                        return fence(T(v + S(1.5) * limit)) - S(1.5) * limit;
+#endif
+                                }
+                        }
+                }
+
+                template<typename T, typename S, size_t K>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T horner(T z, S const (&c)[K])
+                {
+                        T Result = T(c[0]);
+
+                        for (size_t i = 1; i < K; i++)
+                                Result = Result * z + T(c[i]);
+
+                        return Result;
+                }
+
+                template<size_t B, size_t E, typename T, typename S, size_t K>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T estrin_range(T z, S const (&c)[K])
+                {
+                        if constexpr (E - B == 1) {
+                                return T(c[B]);
+                        } else if constexpr (E - B == 2) {
+                                return T(c[B]) * z + T(c[B + 1]);
+                        } else {
+                                constexpr size_t M = std::bit_floor(E - B - 1);
+                                return estrin_range<B, E - M>(z, c) * vrt::pow<int(M)>(z) + estrin_range<E - M, E>(z, c);
+                        }
+                }
+
+                /* 与 horner() 计算同一多项式（c 从高次到低次），按 Estrin 方式拆分，依赖链长度为 O(log K)，
+                   用于没有 FMA 时延迟较长的长多项式 */
+                template<typename T, typename S, size_t K>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T estrin(T z, S const (&c)[K])
+                {
+                        return estrin_range<0, K>(z, c);
+                }
+
+                /* Cephes sin / cos 系数与 π/2 的多段拆分，多项式在 [-π/4, π/4] 上有效；
+                   float 的前三段各不超过 11 位有效位，|q| < 2^13 时 q * pio2[i] 精确；
+                   |x| > reduce_max 时多段拆分不再精确，改用 std::sin / std::cos */
+                template<typename S>
+                struct trig;
+
+                template<>
+                struct trig<float> {
+                        static constexpr float reduce_max = 8192.0f;
+                        static constexpr float pio2[] = { 0x1.92p0f, 0x1.fb4p-12f, 0x1.444p-24f, 0x1.68c234p-39f };
+                        static constexpr float sin[] = { -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f };
+                        static constexpr float cos[] = { 2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f };
+                };
+
+                template<>
+                struct trig<double> {
+                        static constexpr double reduce_max = 0x1p20;
+                        static constexpr double pio2[] = { 1.57079625129699707031e0, 7.54978941586159635335e-8, 5.39030285815811905290e-15 };
+                        static constexpr double sin[] = {
+                                1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+                                -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1
+                        };
+                        static constexpr double cos[] = {
+                                -1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+                                2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2
+                        };
+                };
+
+                /* sincos() 中超出范围的通道改用 std 逐个计算。很少执行，单独成为不内联的函数，以免 sincos() 体积过大而不再被内联；
+                   参数按引用传递，跳板内调用时不涉及向量寄存器的 ABI */
+                template<typename T, typename M>
+                VRT_FUNC_DECL __attribute__((noinline, cold)) void sincos_far(T const& x, M const& far, T& s, T& c)
+                {
+                        typedef scalar_t<T> S;
+
+                        where(far, s) = T([&](auto i) { return std::sin(S(x[i])); });
+                        where(far, c) = T([&](auto i) { return std::cos(S(x[i])); });
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void sincos(T x, T& s, T& c)
+                {
+                        typedef scalar_t<T> S;
+                        typedef trig<S> K;
+
+                        /* 超出范围缩减精度的参数（以及 NaN、inf）交给 std，常量求值时交给 long double 实现，
+                           此后 |q| ≤ reduce_max * 2/π，转换为整数不会溢出；标量为一次几乎总是预测成功的分支 */
+                        if constexpr (!is_packet_v<T>) {
+                                if (!(x >= -K::reduce_max && x <= K::reduce_max)) {
+                                        if consteval {
+                                                ce_t cs, cc;
+                                                ce_sincos(x, cs, cc);
+                                                s = T(cs);
+                                                c = T(cc);
+                                        } else {
+                                                s = std::sin(x);
+                                                c = std::cos(x);
+                                        }
+                                        return;
+                                }
+                        }
+
+                        /* 象限 q = round(x / (π/2))，r = x - q * π/2 ∈ [-π/4, π/4] */
+                        T q = round_nearest(T(x * S(0.636619772367581343076)));
+                        T r = x;
+
+                        for (S p : K::pio2)
+                                r = fence(T(r - q * p));
+
+                        T z = r * r;
+
+                        T ps = r + r * z * horner(z, K::sin);
+                        T pc = S(1) - S(0.5) * z + z * z * horner(z, K::cos);
+
+                        /* q mod 4：1、3 象限交换 sin / cos，2、3 象限 sin 取反，1、2 象限 cos 取反 */
+                        if constexpr (is_packet_v<T>) {
+                                T m = q - S(4) * round_nearest(T(q * S(0.25) - S(0.375)));
+
+                                auto swap = (m == S(1)) | (m == S(3));
+
+                                s = select(swap, pc, ps);
+                                c = select(swap, ps, pc);
+                                s = select(m >= S(2), T(-s), s);
+                                c = select((m == S(1)) | (m == S(2)), T(-c), c);
+
+                                /* 超出范围的通道上述结果无意义，逐通道以 std 重新计算 */
+                                /* NaN 与 inf 经多项式后已是 NaN，只需检查 |x| */
+                                auto far = abs(x) > T(K::reduce_max);
+
+                                if (any(far))
+                                        sincos_far(x, far, s, c);
+                        } else {
+                                /* 标量以整数位运算选择，避免随象限变化、无法预测的分支 */
+                                long long m = static_cast<long long>(q);
+                                T p[2] = { ps, pc };
+
+                                s = p[m & 1] * T(1 - (m & 2));
+                                c = p[(m + 1) & 1] * T(1 - ((m + 1) & 2));
+                        }
+                }
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T sin(T x)
+        {
+                T s, c;
+                detail::sincos(x, s, c);
+
+                return s;
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T cos(T x)
+        {
+                T s, c;
+                detail::sincos(x, s, c);
+
+                return c;
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR void sincos(T x, T& s, T& c)
+        {
+                detail::sincos(x, s, c);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T tan(T x)
+        {
+                T s, c;
+                detail::sincos(x, s, c);
+
+                return s / c;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> sin(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> s, c;
+                sincos(v, s, c);
+
+                return s;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> cos(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> s, c;
+                sincos(v, s, c);
+
+                return c;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> tan(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> s, c;
+                sincos(v, s, c);
+
+                return s / c;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR void sincos(vec<L, T, Q> const& v, vec<L, T, Q>& s, vec<L, T, Q>& c)
+        {
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::simd_t<L, T, Q> ps, pc;
+                                detail::sincos(detail::load(v), ps, pc);
+
+                                detail::store(ps, s);
+                                detail::store(pc, c);
+                                return;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        detail::sincos(v[i], s[i], c[i]);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR void sincos_deg(int angdeg, T& s, T& c)
+        {
+                typedef detail::scalar_t<T> U;
+
+                int k = angdeg % 360;
+
+                if (k < 0)
+                        k += 360;
+
+                s = T(detail::degree_table_v<U>.s[k]);
+                c = T(detail::degree_table_v<U>.c[k]);
+        }
+
+        namespace detail
+        {
+                /* 逐通道调用标量函数 f，用于没有多项式实现的类型（double）；常量求值时改用 constexpr 实现 ce */
+                template<typename T, typename F, typename C>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T lanewise(T x, F f, C ce)
+                {
+                        if constexpr (is_packet_v<T>) {
+                                return T([&](auto i) { return f(scalar_t<T>(x[i])); });
+                        } else {
+                                if consteval {
+                                        return T(ce(x));
+                                } else {
+                                        return f(x);
+                                }
+                        }
+                }
+
+                template<typename T, typename F, typename C>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T lanewise(T y, T x, F f, C ce)
+                {
+                        if constexpr (is_packet_v<T>) {
+                                return T([&](auto i) { return f(scalar_t<T>(y[i]), scalar_t<T>(x[i])); });
+                        } else {
+                                if consteval {
+                                        return T(ce(y, x));
+                                } else {
+                                        return f(y, x);
+                                }
+                        }
+                }
+
+                /* Cephes asinf / atanf 系数 */
+                static constexpr float asin_coef[] = { 4.2163199048e-2f, 2.4181311049e-2f, 4.5470025998e-2f, 7.4953002686e-2f, 1.6666752422e-1f };
+                static constexpr float atan_coef[] = { 8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f };
+
+                /* 计算 p = asin(t)，其中 |x| ≤ 0.5 时 t = |x|，否则 t = sqrt((1 - |x|) / 2)；big 标记后一种情况 */
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T asin_core(T a, decltype(a > a)& big)
+                {
+                        big = a > 0.5f;
+
+                        T z = select(big, T(0.5f * (1.0f - a)), T(a * a));
+                        T t = select(big, vrt::sqrt(z), a);
+
+                        return t + t * z * horner(z, asin_coef);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T asin(T x)
+                {
+                        using std::abs;
+
+                        decltype(x > x) big;
+                        T a = abs(x);
+                        T p = asin_core(a, big);
+                        T r = select(big, T(1.57079632679489661923f - 2.0f * p), p);
+
+                        return select(x < 0.0f, T(-r), r);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T acos(T x)
+                {
+                        using std::abs;
+
+                        decltype(x > x) big;
+                        T a = abs(x);
+                        T p = asin_core(a, big);
+
+                        /* |x| ≤ 0.5：π/2 - asin(x)；x > 0.5：2p；x < -0.5：π - 2p */
+                        T small = 1.57079632679489661923f - select(x < 0.0f, T(-p), p);
+                        T large = select(x < 0.0f, T(3.14159265358979323846f - 2.0f * p), T(2.0f * p));
+
+                        return select(big, large, small);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T atan(T x)
+                {
+                        using std::abs;
+
+                        T a = abs(x);
+
+                        auto big = a > 2.414213562373095f;      /* tan(3π/8) */
+                        auto mid = a > 0.4142135623730950f;     /* tan(π/8) */
+
+                        T y = select(big, T(1.57079632679489661923f), select(mid, T(0.78539816339744830962f), T(0.0f)));
+                        T r = select(big, T(-1.0f / a), select(mid, T((a - 1.0f) / (a + 1.0f)), a));
+                        T z = r * r;
+
+                        y = y + (r + r * z * horner(z, atan_coef));
+
+                        return select(x < 0.0f, T(-y), y);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR T atan2(T y, T x)
+                {
+                        T r = atan(T(y / x));
+
+                        /* x < 0 时按 y 的符号加减 π；x、y 同为 0 时 y / x 为 NaN，返回 0 */
+                        r = select(x < 0.0f, T(r + select(y < 0.0f, T(-3.14159265358979323846f), T(3.14159265358979323846f))), r);
+
+                        return select((x == 0.0f) & (y == 0.0f), T(0.0f), r);
+                }
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T arccos(T x)
+        {
+                if constexpr (std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::acos(x);
+                else
+                        return detail::lanewise(x, [](auto v) { return std::acos(v); }, detail::ce_acos);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T arcsin(T x)
+        {
+                if constexpr (std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::asin(x);
+                else
+                        return detail::lanewise(x, [](auto v) { return std::asin(v); }, detail::ce_asin);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T arctan(T x)
+        {
+                if constexpr (std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::atan(x);
+                else
+                        return detail::lanewise(x, [](auto v) { return std::atan(v); }, detail::ce_atan);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T arctan2(T y, T x)
+        {
+                if constexpr (std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::atan2(y, x);
+                else
+                        return detail::lanewise(y, x, [](auto a, auto b) { return std::atan2(a, b); }, detail::ce_atan2);
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> arccos(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(arccos(detail::load(v)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = arccos(v[i]);
+
+                return Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> arcsin(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(arcsin(detail::load(v)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = arcsin(v[i]);
+
+                return Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> arctan(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(arctan(detail::load(v)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = arctan(v[i]);
+
+                return Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> arctan2(vec<L, T, Q> const& y, vec<L, T, Q> const& x)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(arctan2(detail::load(y), detail::load(x)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = arctan2(y[i], x[i]);
+
+                return Result;
+        }
+        
+        namespace detail
+        {
+                template<typename T, bool = is_packet_v<T>>
+                struct int_bits { typedef int32_t type; };
+
+                template<typename T>
+                struct int_bits<T, true> { typedef std::experimental::rebind_simd_t<int32_t, T> type; };
+
+                /* float 标量或 packet 的位模式与整数互转，packet 对应同宽的 int32 simd */
+                template<typename T>
+                using int_bits_t = typename int_bits<T>::type;
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE int_bits_t<T> as_int(T x)
+                {
+                        if constexpr (is_packet_v<T>)
+                                return std::experimental::__proposed::simd_bit_cast<int_bits_t<T>>(x);
+                        else
+                                return std::bit_cast<int32_t>(x);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T as_float(int_bits_t<T> i)
+                {
+                        if constexpr (is_packet_v<T>)
+                                return std::experimental::__proposed::simd_bit_cast<T>(i);
+                        else
+                                return std::bit_cast<float>(i);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE int_bits_t<T> to_int(T x)
+                {
+                        if constexpr (is_packet_v<T>)
+                                return std::experimental::static_simd_cast<int_bits_t<T>>(x);
+                        else
+                                return static_cast<int32_t>(x);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T to_float(int_bits_t<T> i)
+                {
+                        if constexpr (is_packet_v<T>)
+                                return std::experimental::static_simd_cast<T>(i);
+                        else
+                                return static_cast<float>(i);
+                }
+
+                /* Cephes expf / exp2f / logf 系数 */
+                static constexpr float exp_coef[] = { 1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f };
+                static constexpr float exp2_coef[] = { 1.535336188319500e-4f, 1.339887440266574e-3f, 9.618437357674640e-3f, 5.550332471162809e-2f, 2.402264791363012e-1f, 6.931472028550421e-1f };
+                static constexpr float log_coef[] = {
+                        7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f, -1.2420140846e-1f, 1.4249322787e-1f,
+                        -1.6668057665e-1f, 2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f
+                };
+
+                /* p * 2^n，n 为整数值且 n ∈ [-152, 130]（NaN 视为 0）；2^n 拆成两个正规数因子相乘，
+                   使上溢得到 inf、下溢经过非正规数逐渐变为 0 */
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T scale2(T p, T n)
+                {
+                        int_bits_t<T> k = to_int(select(n == n, n, T(0.0f)));
+                        int_bits_t<T> h = k >> 1;
+
+                        return p * as_float<T>((h + 127) << 23) * as_float<T>((k - h + 127) << 23);
+                }
+
+                /* 限制到 [lo, hi]，NaN 保持不变 */
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T clamp(T x, float lo, float hi)
+                {
+                        return select(x < lo, T(lo), select(x > hi, T(hi), x));
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T exp(T x)
+                {
+                        x = clamp(x, -105.0f, 90.0f);
+
+                        /* x = n * ln2 + r，ln2 拆为 0.693359375（9 位有效位，n * C1 精确）与 -2.12194440e-4 */
+                        T n = round_nearest(T(x * 1.44269504088896341f));
+                        T r = x - n * 0.693359375f - n * -2.12194440e-4f;
+
+                        return scale2(T(estrin(r, exp_coef) * (r * r) + r + 1.0f), n);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T exp2(T x)
+                {
+                        x = clamp(x, -152.0f, 130.0f);
+
+                        T n = round_nearest(x);
+                        T f = x - n;
+
+                        return scale2(T(f * estrin(f, exp2_coef) + 1.0f), n);
+                }
+
+                /* x = 2^e * m，m ∈ [√½, √2)；返回 e，u = m - 1，y = ln(m) - u（多项式部分）；
+                   x 为 0、负数、inf 或 NaN 时结果无意义，由调用者处理 */
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T log_reduce(T x, T& u, T& y)
+                {
+                        T bias(126.0f);
+
+                        /* 非正规数先放大 2^23，使尾数规格化 */
+                        if (any(x < std::numeric_limits<float>::min())) {
+                                auto tiny = x < std::numeric_limits<float>::min();
+
+                                x = select(tiny, T(x * 8388608.0f), x);
+                                bias = select(tiny, T(149.0f), bias);
+                        }
+
+                        int_bits_t<T> i = as_int(x);
+
+                        T e = to_float<T>((i >> 23) & 0xff) - bias;
+                        T m = as_float<T>((i & 0x007fffff) | 0x3f000000);  /* [0.5, 1) */
+
+                        auto low = m < 0.707106781186547524f;
+
+                        e = select(low, T(e - 1.0f), e);
+                        u = select(low, T(m + m - 1.0f), T(m - 1.0f));
+
+                        T z = u * u;
+                        y = u * z * estrin(u, log_coef) - 0.5f * z;
+
+                        return e;
+                }
+
+                /* x 不在 (0, inf) 内，需要按特殊值处理 */
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE bool any_special(T x)
+                {
+                        return any(!((x > 0.0f) & (x < std::numeric_limits<float>::infinity())));
+                }
+
+                /* 定义域外的输入：+inf → +inf，NaN → NaN，负数 → NaN，0 → -inf */
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T log_special(T x, T r)
+                {
+                        r = select(x < std::numeric_limits<float>::infinity(), r, x);
+                        r = select(x < 0.0f, T(std::numeric_limits<float>::quiet_NaN()), r);
+
+                        return select(x == 0.0f, T(-std::numeric_limits<float>::infinity()), r);
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T log(T x)
+                {
+                        T u, y;
+                        T e = log_reduce(x, u, y);
+
+                        /* e * ln2 同样拆为两段 */
+                        T r = (u + (y + e * -2.12194440e-4f)) + e * 0.693359375f;
+
+                        return any_special(x) ? log_special(x, r) : r;
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T log2(T x)
+                {
+                        T u, y;
+                        T e = log_reduce(x, u, y);
+
+                        /* ln(m) * log2(e) = (u + y) + (u + y) * (log2(e) - 1)，避免 log2(e) 舍入放大误差 */
+                        T r = (y * 0.44269504088896340736f + u * 0.44269504088896340736f + y + u) + e;
+
+                        return any_special(x) ? log_special(x, r) : r;
+                }
+
+                template<typename T>
+                VRT_FUNC_DECL VRT_INLINE T pow(T x, T a)
+                {
+                        T u, y;
+                        T e = log_reduce(x, u, y);
+                        T t = y * 0.44269504088896340736f + u * 0.44269504088896340736f + y + u;  /* log2(m) */
+
+                        /* a * log2(x) = a * e + a * t：a、t 各拆为高 12 位（ah、th）与余下部分，ah * e 与 ah * th 都是精确的，
+                           各自减去最近的整数后再相加，舍入误差不随 |a| 增大 */
+                        T ah = as_float<T>(as_int(a) & int32_t(0xfffff000));
+                        T th = as_float<T>(as_int(t) & int32_t(0xfffff000));
+                        T h1 = ah * e;
+                        T h2 = ah * th;
+                        T k1 = round_nearest(h1);
+                        T k2 = round_nearest(h2);
+                        T w = ((h1 - k1) + (h2 - k2)) + ((a - ah) * (e + th) + a * (t - th));
+                        T m = round_nearest(w);
+                        T f = w - m;
+
+                        T Result = scale2(T(f * estrin(f, exp2_coef) + 1.0f), clamp(T(k1 + k2 + m), -152.0f, 130.0f));
+
+                        if (any_special(x)) {
+                                /* x 为 0：a > 0 时为 0，a < 0 时为 inf；x 为 +inf 时相反；负数与 NaN 为 NaN；a 为 0 时为 1 */
+                                Result = select(x == 0.0f, select(a < 0.0f, T(std::numeric_limits<float>::infinity()), select(a > 0.0f, T(0.0f), a)), Result);
+                                Result = select(x == std::numeric_limits<float>::infinity(), select(a < 0.0f, T(0.0f), T(x * a)), Result);
+                                Result = select(x >= 0.0f, Result, T(std::numeric_limits<float>::quiet_NaN()));
+                                Result = select(a == 0.0f, T(1.0f), Result);
+                        }
+
+                        return Result;
+                }
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T exp(T x)
+        {
+                if constexpr (detail::is_packet_v<T> && std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::exp(x);
+                else
+                        return detail::lanewise(x, [](auto v) { return std::exp(v); }, detail::ce_exp);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T exp2(T x)
+        {
+                if constexpr (detail::is_packet_v<T> && std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::exp2(x);
+                else
+                        return detail::lanewise(x, [](auto v) { return std::exp2(v); }, detail::ce_exp2);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T log(T x)
+        {
+                if constexpr (detail::is_packet_v<T> && std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::log(x);
+                else
+                        return detail::lanewise(x, [](auto v) { return std::log(v); }, detail::ce_log);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T log2(T x)
+        {
+                if constexpr (detail::is_packet_v<T> && std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::log2(x);
+                else
+                        return detail::lanewise(x, [](auto v) { return std::log2(v); }, detail::ce_log2);
+        }
+
+        template<typename T>
+        VRT_FUNC_CONSTEXPR T pow(T x, T a)
+        {
+                if constexpr (detail::is_packet_v<T> && std::is_same_v<detail::scalar_t<T>, float>)
+                        return detail::pow(x, a);
+                else
+                        return detail::lanewise(x, a, [](auto b, auto e) { return std::pow(b, e); }, detail::ce_pow);
+        }
+
+        template<int N, typename T>
+        VRT_FUNC_CONSTEXPR T pow(T x)
+        {
+                if constexpr (N < 0) {
+                        return T(1) / pow<-N>(x);
+                } else if constexpr (N == 0) {
+                        return T(1);
+                } else if constexpr (N == 1) {
+                        return x;
+                } else {
+                        T h = pow<N / 2>(x);
+
+                        if constexpr (N % 2)
+                                return h * h * x;
+                        else
+                                return h * h;
+                }
+        }
+
+        template<typename T, std::integral I>
+        VRT_FUNC_CONSTEXPR T pow(T x, I n)
+        {
+                /* 先转为无符号数取绝对值，n 为最小负数时也不会溢出 */
+                std::make_unsigned_t<I> k = n < 0 ? 0u - std::make_unsigned_t<I>(n) : std::make_unsigned_t<I>(n);
+
+                T Result(1);
+
+                for (; k != 0; k >>= 1) {
+                        if (k & 1)
+                                Result *= x;
+                        x *= x;
+                }
+
+                return n < 0 ? T(1) / Result : Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> pow(vec<L, T, Q> const& v, vec<L, T, Q> const& a)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(vrt::pow(detail::load(v), detail::load(a)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = vrt::pow(v[i], a[i]);
+
+                return Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> pow(vec<L, T, Q> const& v, T a)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(vrt::pow(detail::load(v), detail::simd_t<L, T, Q>(a)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = vrt::pow(v[i], a);
+
+                return Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> exp(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(vrt::exp(detail::load(v)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = vrt::exp(v[i]);
+
+                return Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> exp2(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(vrt::exp2(detail::load(v)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = vrt::exp2(v[i]);
+
+                return Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> log(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(vrt::log(detail::load(v)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = vrt::log(v[i]);
+
+                return Result;
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> log2(vec<L, T, Q> const& v)
+        {
+                vec<L, T, Q> Result;
+
+                if constexpr (!detail::is_packet_v<T>) {
+                        if !consteval {
+                                detail::store(vrt::log2(detail::load(v)), Result);
+                                return Result;
+                        }
+                }
+
+                for (size_t i = 0; i < L; i++)
+                        Result[i] = vrt::log2(v[i]);
+
+                return Result;
+        }
+
+        VRT_INLINE packet<float> sin(packet<float> x)
+        {
+                return vrt::sin<packet<float>>(x);
+        }
+
+        VRT_INLINE packet<float> cos(packet<float> x)
+        {
+                return vrt::cos<packet<float>>(x);
+        }
+
+        VRT_INLINE packet<float> tan(packet<float> x)
+        {
+                return vrt::tan<packet<float>>(x);
+        }
+
+        VRT_INLINE packet<float> exp(packet<float> x)
+        {
+                return vrt::exp<packet<float>>(x);
+        }
+
+        VRT_INLINE packet<float> exp2(packet<float> x)
+        {
+                return vrt::exp2<packet<float>>(x);
+        }
+
+        VRT_INLINE packet<float> log(packet<float> x)
+        {
+                return vrt::log<packet<float>>(x);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T sin(T x)
+        VRT_INLINE packet<float> log2(packet<float> x)
         {
-                return std::sin(x);
+                return vrt::log2<packet<float>>(x);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T cos(T x)
+        VRT_INLINE packet<float> pow(packet<float> x, packet<float> a)
         {
-                return std::cos(x);
+                return vrt::pow<packet<float>>(x, a);
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T arccos(T x)
+        VRT_INLINE packet<double> sin(packet<double> x)
+        {
+                return vrt::sin<packet<double>>(x);
+        }
+
+        VRT_INLINE packet<double> cos(packet<double> x)
+        {
+                return vrt::cos<packet<double>>(x);
+        }
+
+        VRT_INLINE packet<double> tan(packet<double> x)
+        {
+                return vrt::tan<packet<double>>(x);
+        }
+
+        VRT_INLINE packet<double> exp(packet<double> x)
+        {
+                return vrt::exp<packet<double>>(x);
+        }
+
+        VRT_INLINE packet<double> exp2(packet<double> x)
+        {
+                return vrt::exp2<packet<double>>(x);
+        }
+
+        VRT_INLINE packet<double> log(packet<double> x)
+        {
+                return vrt::log<packet<double>>(x);
+        }
+
+        VRT_INLINE packet<double> log2(packet<double> x)
+        {
+                return vrt::log2<packet<double>>(x);
+        }
+
+        VRT_INLINE packet<double> pow(packet<double> x, packet<double> a)
         {
-                return std::acos(x);
+                return vrt::pow<packet<double>>(x, a);
         }
         
         template<typename T>
         VRT_FUNC_CONSTEXPR T sqrt(T x)
         {
-                return std::sqrt(x);
+                if constexpr (detail::is_packet_v<T>) {
+                        /* simd 使用 std::experimental::sqrt，其他数据包（批量内核的 detail::wide）按 ADL 查找 */
+                        using std::experimental::sqrt;
+                        return sqrt(x);
+                } else {
+                        if consteval {
+                                return T(detail::ce_sqrt(x));
+                        } else {
+                                return std::sqrt(x);
+                        }
+                }
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<2, T> sqrt(vec<2, T> const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<2, T, Q> sqrt(vec<2, T, Q> const& v)
         {
-                using namespace std::experimental;
+                if consteval {
+                        return vec<2, T, Q>(sqrt(v.x), sqrt(v.y));
+                }
 
-                std::experimental::native_simd<T> data;
-                data.copy_from(&v[0], element_aligned);
-                auto Result = std::experimental::sqrt(data);
+                vec<2, T, Q> Result;
+                detail::store(std::experimental::sqrt(detail::load(v)), Result);
 
-                return vec<2, T>(Result[0], Result[1]);
+                return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<3, T> sqrt(vec<3, T> const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> sqrt(vec<3, T, Q> const& v)
         {
-                using namespace std::experimental;
+                if consteval {
+                        return vec<3, T, Q>(sqrt(v.x), sqrt(v.y), sqrt(v.z));
+                }
 
-                std::experimental::native_simd<T> data;
-                data.copy_from(&v[0], element_aligned);
-                auto Result = std::experimental::sqrt(data);
+                vec<3, T, Q> Result;
+                detail::store(std::experimental::sqrt(detail::load(v)), Result);
 
-                return vec<3, T>(Result[0], Result[1], Result[2]);
+                return Result;
         }
         
-        template<typename T>
-        VRT_FUNC_CONSTEXPR vec<4, T> sqrt(vec<4, T> const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<4, T, Q> sqrt(vec<4, T, Q> const& v)
         {
-                using namespace std::experimental;
+                if consteval {
+                        return vec<4, T, Q>(sqrt(v.x), sqrt(v.y), sqrt(v.z), sqrt(v.w));
+                }
 
-                std::experimental::native_simd<T> data;
-                data.copy_from(&v[0], element_aligned);
-                auto Result = std::experimental::sqrt(data);
+                vec<4, T, Q> Result;
+                detail::store(std::experimental::sqrt(detail::load(v)), Result);
 
-                return vec<4, T>(Result[0], Result[1], Result[2], Result[3]);
+                return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T reduce(vec<2, T> const& v)
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T reduce(vec<L, T, Q> const& v)
         {
-                return (v.x + v.y);
+                /* 宽向量整体加载后做水平规约，避免逐分量累加形成的串行依赖链 */
+                if constexpr (L > 4) {
+                        if !consteval {
+                                return std::experimental::reduce(detail::load(v));
+                        }
+                }
+
+                T Result = v[0];
+
+                for (size_t i = 1; i < L; i++)
+                        Result += v[i];
+
+                return Result;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T reduce(vec<3, T> const& v)
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T angle(vec<L, T, Q> const& v1, vec<L, T, Q> const& v2)
         {
-                return (v.x + v.y + v.z);
+                T n = dot(v1, v1) * dot(v2, v2);
+                T c = dot(v1, v2) / sqrt(n);
+
+                c = detail::select(c > T(1), T(1), detail::select(c < T(-1), T(-1), c));
+
+                return detail::select(n > T(0), arccos(c), T(0));
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR T reduce(vec<4, T> const& v)
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T fast_angle(vec<L, T, Q> const& v1, vec<L, T, Q> const& v2)
         {
-                return (v.x + v.y + v.z + v.w);
+                T n = dot(v1, v1) * dot(v2, v2);
+                T c = dot(v1, v2) * inverse_sqrt(n);
+
+                c = detail::select(c > T(1), T(1), detail::select(c < T(-1), T(-1), c));
+
+                return detail::select(n > T(0), arccos(c), T(0));
         }
 
-        template<size_t L, typename T>
-        VRT_FUNC_CONSTEXPR T angle(vec<L, T> const& v1, vec<L, T> const& v2)
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T dot(vec<L, T, Q> const& v1, vec<L, T, Q> const& v2)
         {
-                T lv1 = length(v1);
-                T lv2 = length(v2);
+                if constexpr (L > 4) {
+                        if !consteval {
+                                return std::experimental::reduce(detail::load(v1) * detail::load(v2));
+                        }
+                }
 
-                if (!lv1 || !lv2)
-                        return T(0);
+                T Result = v1[0] * v2[0];
 
-                return arccos(dot(v1, v2) / (lv1 * lv2));
+                for (size_t i = 1; i < L; i++)
+                        Result += v1[i] * v2[i];
+
+                return Result;
         }
 
-        template<size_t L, typename T>
-        VRT_FUNC_CONSTEXPR T dot(vec<L, T> const& v1, vec<L, T> const& v2)
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T length(vec<L, T, Q> const& v)
         {
-                return reduce(v1 * v2);
+                return sqrt(dot(v, v));
         }
 
-        template<size_t L, typename T>
-        VRT_FUNC_CONSTEXPR T length(vec<L, T> const& v)
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> normalize(vec<L, T, Q> const& v)
         {
-                return sqrt(reduce(v * v));
+                return v / length(v);
         }
 
-        template<size_t L, typename T>
-        VRT_FUNC_CONSTEXPR vec<L, T> normalize(vec<L, T> const& v)
+        namespace detail
         {
-                return v / length(v);
+                /* 补齐到 4 通道的 float vec3 按 16 字节对齐，可以整体放入一个 SSE 寄存器 */
+                template<typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool has_sse_vec3()
+                {
+#if defined(__SSE__)
+                        return std::is_same_v<T, float> && lanes<3, Q>::value == 4;
+#else
+                        return false;
+#endif
+                }
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR mat<4, T> translate(mat<4, T> const& m, vec<3, T> const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<3, T, Q> cross(vec<3, T, Q> const& v1, vec<3, T, Q> const& v2)
+        {
+#if defined(__SSE__)
+                if constexpr (detail::has_sse_vec3<T, Q>()) {
+                        if !consteval {
+                                __m128 a = _mm_load_ps(v1.data);
+                                __m128 b = _mm_load_ps(v2.data);
+
+                                /* 补齐通道为 0，乘积相减后仍为 0，结果可以直接整宽存储 */
+                                __m128 c = _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1))),
+                                                      _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), b));
+
+                                vec<3, T, Q> Result;
+                                _mm_store_ps(Result.data, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)));
+
+                                return Result;
+                        }
+                }
+#endif
+                return vec<3, T, Q>(v1.y * v2.z - v1.z * v2.y,
+                                    v1.z * v2.x - v1.x * v2.z,
+                                    v1.x * v2.y - v1.y * v2.x);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T triple(vec<3, T, Q> const& a, vec<3, T, Q> const& b, vec<3, T, Q> const& c)
+        {
+                return dot(a, cross(b, c));
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR void orthonormal_basis(vec<3, T, Q> const& n, vec<3, T, Q>& b1, vec<3, T, Q>& b2)
+        {
+                T s = detail::select(n.z < T(0), T(-1), T(1));
+                T a = T(-1) / (s + n.z);
+                T b = n.x * n.y * a;
+
+                b1 = vec<3, T, Q>(T(1) + s * n.x * n.x * a, s * b, -s * n.x);
+                b2 = vec<3, T, Q>(b, s + n.y * n.y * a, -n.y);
+        }
+
+        namespace detail
         {
-                mat<4, T> t(1.0f);
+                /* 是否有硬件倒数平方根估计：float 标量，以及与 SSE / AVX / AVX-512 寄存器等宽的 float packet */
+                template<typename T>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR bool has_rsqrt()
+                {
+#if defined(__SSE__)
+                        if constexpr (std::is_same_v<T, float>) {
+                                return true;
+                        } else if constexpr (is_packet_v<T>) {
+                                if constexpr (std::is_same_v<typename T::value_type, float>) {
+                                        if (sizeof(T) == 16)
+                                                return true;
+#  if defined(__AVX__)
+                                        if (sizeof(T) == 32)
+                                                return true;
+#  endif
+#  if defined(__AVX512F__)
+                                        if (sizeof(T) == 64)
+                                                return true;
+#  endif
+                                }
+                        }
+#endif
+                        return false;
+                }
 
-                t[3][0] = v[0];
-                t[3][1] = v[1];
-                t[3][2] = v[2];
-                
-                return m * t;
+                template<typename T>
+                requires (has_rsqrt<T>())
+                VRT_FUNC_DECL VRT_INLINE T rsqrt_estimate(T x)
+                {
+                        if constexpr (std::is_same_v<T, float>)
+                                return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+                        else if constexpr (sizeof(T) == 16)
+                                return T(_mm_rsqrt_ps(static_cast<__m128>(x)));
+#if defined(__AVX512F__)
+                        else if constexpr (sizeof(T) == 64)
+                                return T(_mm512_maskz_rsqrt14_ps(0xFFFF, static_cast<__m512>(x)));
+#endif
+#if defined(__AVX__)
+                        else
+                                return T(_mm256_rsqrt_ps(static_cast<__m256>(x)));
+#endif
+                }
         }
 
         template<typename T>
-        VRT_FUNC_CONSTEXPR mat<4, T> rotate(mat<4, T> const& m, T angle, vec<3, T> const& v)
-        {
-                T a = radians(-angle) / 2; /* 使用右手坐标系 */
-                
-                T w = cos(a);
-                T s = sin(a);
-                
-                vec<3, T> axis = normalize(v);
-                
-                T x = axis.x * s;
-                T y = axis.y * s;
-                T z = axis.z * s;
-                
-                mat<4, T> r = {
-                    1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y), 0,
-                    2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x), 0,
-                    2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y), 0,
-                    0, 0, 0, 1
+        VRT_FUNC_CONSTEXPR T inverse_sqrt(T x)
+        {
+                if constexpr (detail::has_rsqrt<T>()) {
+                        if !consteval {
+                                /* 硬件估计把非规格化数当作 0，先放大 2^24 进入规格化范围，结果再乘 2^12 还原 */
+                                auto tiny = x < T(std::numeric_limits<float>::min());
+                                T u = x * detail::select(tiny, T(16777216.0f), T(1.0f));
+                                T y = detail::rsqrt_estimate(u);
+                                T t = (T(0.5f) * u * y) * y;
+
+                                /* u 为 0 或 inf 时 t = 0 * inf 为 NaN，此时估计值（inf / 0）本身就是准确结果 */
+                                y = detail::select(t == t, T(y * (T(1.5f) - t)), y);
+                                return y * detail::select(tiny, T(4096.0f), T(1.0f));
+                        }
+                }
+
+                return T(1) / sqrt(x);
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T inverse_length(vec<L, T, Q> const& v)
+        {
+                return inverse_sqrt(dot(v, v));
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T fast_length(vec<L, T, Q> const& v)
+        {
+                T d = dot(v, v);
+                return d * inverse_sqrt(d);
+        }
+
+        template<size_t L, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR vec<L, T, Q> fast_normalize(vec<L, T, Q> const& v)
+        {
+                return v * inverse_length(v);
+        }
+
+        namespace detail
+        {
+                /* 绕轴 v 旋转的矩阵（Rodrigues 公式），s、c 为旋转角的正弦与余弦，只有左上 3x3 非单位 */
+                template<typename T, qualifier Q, qualifier P>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> axis_rotation(T s, T c, vec<3, T, P> const& v)
+                {
+                        vec<3, T, P> axis = normalize(v);
+
+                        T x = axis.x;
+                        T y = axis.y;
+                        T z = axis.z;
+                        T t = 1 - c;
+
+                        return mat<4, T, Q> {
+                            c + x * x * t, x * y * t + z * s, x * z * t - y * s, 0,
+                            x * y * t - z * s, c + y * y * t, y * z * t + x * s, 0,
+                            x * z * t + y * s, y * z * t - x * s, c + z * z * t, 0,
+                            0, 0, 0, 1
+                        };
+                }
+
+                /* m = m * r，r 只有左上 3x3 非单位：第 3 列不变，前三列各 3 次列广播乘加 */
+                template<typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void mul_linear(mat<4, T, Q>& m, mat<4, T, Q> const& r)
+                {
+                        if consteval {
+                                vec<4, T, Q> r0 = m[0] * r[0].x + m[1] * r[0].y + m[2] * r[0].z;
+                                vec<4, T, Q> r1 = m[0] * r[1].x + m[1] * r[1].y + m[2] * r[1].z;
+                                vec<4, T, Q> r2 = m[0] * r[2].x + m[1] * r[2].y + m[2] * r[2].z;
+
+                                m[0] = r0;
+                                m[1] = r1;
+                                m[2] = r2;
+                                return;
+                        }
+
+                        simd_t<4, T, Q> c0 = load(m[0]);
+                        simd_t<4, T, Q> c1 = load(m[1]);
+                        simd_t<4, T, Q> c2 = load(m[2]);
+
+                        store(c0 * r[0].x + c1 * r[0].y + c2 * r[0].z, m[0]);
+                        store(c0 * r[1].x + c1 * r[1].y + c2 * r[1].z, m[1]);
+                        store(c0 * r[2].x + c1 * r[2].y + c2 * r[2].z, m[2]);
+                }
+
+                /* m = r * m，r 只有左上 3x3 非单位：每列的 xyz 左乘 3x3，w 不变 */
+                template<typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void pre_mul_linear(mat<4, T, Q>& m, mat<4, T, Q> const& r)
+                {
+                        for (int j = 0; j < 4; j++) {
+                                T x = m[j].x, y = m[j].y, z = m[j].z;
+
+                                m[j].x = r[0].x * x + r[1].x * y + r[2].x * z;
+                                m[j].y = r[0].y * x + r[1].y * y + r[2].y * z;
+                                m[j].z = r[0].z * x + r[1].z * y + r[2].z * z;
+                        }
+                }
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> translate(mat<4, T, Q> const& m, vec<3, T, P> const& v)
+        {
+                mat<4, T, Q> Result = m;
+                return translate_inplace(Result, v);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate(mat<4, T, Q> const& m, T angle, vec<3, T, P> const& v)
+        {
+                mat<4, T, Q> Result = m;
+                return rotate_inplace(Result, angle, v);
+        }
+
+        template<typename T, std::integral I, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate(mat<4, T, Q> const& m, I angle, vec<3, T, P> const& v)
+        {
+                mat<4, T, Q> Result = m;
+                return rotate_inplace(Result, angle, v);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate_x_deg(int angdeg)
+        {
+                T s, c;
+                sincos_deg(angdeg, s, c);
+
+                mat<4, T, Q> Result(1.0f);
+
+                Result[1][1] = c;
+                Result[1][2] = s;
+                Result[2][1] = -s;
+                Result[2][2] = c;
+
+                return Result;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate_y_deg(int angdeg)
+        {
+                T s, c;
+                sincos_deg(angdeg, s, c);
+
+                mat<4, T, Q> Result(1.0f);
+
+                Result[0][0] = c;
+                Result[0][2] = -s;
+                Result[2][0] = s;
+                Result[2][2] = c;
+
+                return Result;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> rotate_z_deg(int angdeg)
+        {
+                T s, c;
+                sincos_deg(angdeg, s, c);
+
+                mat<4, T, Q> Result(1.0f);
+
+                Result[0][0] = c;
+                Result[0][1] = s;
+                Result[1][0] = -s;
+                Result[1][1] = c;
+
+                return Result;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> scale(mat<4, T, Q> const& m, vec<3, T, P> const& v)
+        {
+                mat<4, T, Q> Result = m;
+                return scale_inplace(Result, v);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q>& translate_inplace(mat<4, T, Q>& m, vec<3, T, P> const& v)
+        {
+                if consteval {
+                        m[3] = m[0] * v.x + m[1] * v.y + m[2] * v.z + m[3];
+                        return m;
+                }
+
+                detail::simd_t<4, T, Q> c0 = detail::load(m[0]);
+                detail::simd_t<4, T, Q> c1 = detail::load(m[1]);
+                detail::simd_t<4, T, Q> c2 = detail::load(m[2]);
+                detail::simd_t<4, T, Q> c3 = detail::load(m[3]);
+
+                detail::store(c0 * v.x + c1 * v.y + c2 * v.z + c3, m[3]);
+
+                return m;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q>& scale_inplace(mat<4, T, Q>& m, vec<3, T, P> const& v)
+        {
+                m[0] *= v.x;
+                m[1] *= v.y;
+                m[2] *= v.z;
+
+                return m;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q>& rotate_inplace(mat<4, T, Q>& m, T angle, vec<3, T, P> const& v)
+        {
+                T s, c;
+                vrt::sincos(angle * T(M_PI / 180), s, c);
+
+                detail::mul_linear(m, detail::axis_rotation<T, Q>(s, c, v));
+
+                return m;
+        }
+
+        template<typename T, std::integral I, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q>& rotate_inplace(mat<4, T, Q>& m, I angle, vec<3, T, P> const& v)
+        {
+                T s, c;
+                sincos_deg(int(angle % 360), s, c);
+
+                detail::mul_linear(m, detail::axis_rotation<T, Q>(s, c, v));
+
+                return m;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> pre_translate(mat<4, T, Q> const& m, vec<3, T, P> const& v)
+        {
+                mat<4, T, Q> Result = m;
+                return pre_translate_inplace(Result, v);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> pre_scale(mat<4, T, Q> const& m, vec<3, T, P> const& v)
+        {
+                mat<4, T, Q> Result = m;
+                return pre_scale_inplace(Result, v);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> pre_rotate(mat<4, T, Q> const& m, T angle, vec<3, T, P> const& v)
+        {
+                mat<4, T, Q> Result = m;
+                return pre_rotate_inplace(Result, angle, v);
+        }
+
+        template<typename T, std::integral I, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> pre_rotate(mat<4, T, Q> const& m, I angle, vec<3, T, P> const& v)
+        {
+                mat<4, T, Q> Result = m;
+                return pre_rotate_inplace(Result, angle, v);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q>& pre_translate_inplace(mat<4, T, Q>& m, vec<3, T, P> const& v)
+        {
+                for (int j = 0; j < 4; j++) {
+                        T w = m[j].w;
+
+                        m[j].x += v.x * w;
+                        m[j].y += v.y * w;
+                        m[j].z += v.z * w;
+                }
+
+                return m;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q>& pre_scale_inplace(mat<4, T, Q>& m, vec<3, T, P> const& v)
+        {
+                for (int j = 0; j < 4; j++) {
+                        m[j].x *= v.x;
+                        m[j].y *= v.y;
+                        m[j].z *= v.z;
+                }
+
+                return m;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q>& pre_rotate_inplace(mat<4, T, Q>& m, T angle, vec<3, T, P> const& v)
+        {
+                T s, c;
+                vrt::sincos(angle * T(M_PI / 180), s, c);
+
+                detail::pre_mul_linear(m, detail::axis_rotation<T, Q>(s, c, v));
+
+                return m;
+        }
+
+        template<typename T, std::integral I, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q>& pre_rotate_inplace(mat<4, T, Q>& m, I angle, vec<3, T, P> const& v)
+        {
+                T s, c;
+                sincos_deg(int(angle % 360), s, c);
+
+                detail::pre_mul_linear(m, detail::axis_rotation<T, Q>(s, c, v));
+
+                return m;
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> transform_point(mat<4, T, Q> const& m, vec<3, T, P> const& p)
+        {
+                if consteval {
+                        return vec<3, T, P>(m[0].x * p.x + m[1].x * p.y + m[2].x * p.z + m[3].x,
+                                            m[0].y * p.x + m[1].y * p.y + m[2].y * p.z + m[3].y,
+                                            m[0].z * p.x + m[1].z * p.y + m[2].z * p.z + m[3].z);
+                }
+
+                detail::simd_t<4, T, Q> c0 = detail::load(m[0]);
+                detail::simd_t<4, T, Q> c1 = detail::load(m[1]);
+                detail::simd_t<4, T, Q> c2 = detail::load(m[2]);
+                detail::simd_t<4, T, Q> c3 = detail::load(m[3]);
+
+                detail::simd_t<4, T, Q> r = c0 * p.x + c1 * p.y + c2 * p.z + c3;
+
+                return vec<3, T, P>(r[0], r[1], r[2]);
+        }
+
+        template<typename T, qualifier Q, qualifier P>
+        VRT_FUNC_CONSTEXPR vec<3, T, P> transform_direction(mat<4, T, Q> const& m, vec<3, T, P> const& d)
+        {
+                if consteval {
+                        return vec<3, T, P>(m[0].x * d.x + m[1].x * d.y + m[2].x * d.z,
+                                            m[0].y * d.x + m[1].y * d.y + m[2].y * d.z,
+                                            m[0].z * d.x + m[1].z * d.y + m[2].z * d.z);
+                }
+
+                detail::simd_t<4, T, Q> c0 = detail::load(m[0]);
+                detail::simd_t<4, T, Q> c1 = detail::load(m[1]);
+                detail::simd_t<4, T, Q> c2 = detail::load(m[2]);
+
+                detail::simd_t<4, T, Q> r = c0 * d.x + c1 * d.y + c2 * d.z;
+
+                return vec<3, T, P>(r[0], r[1], r[2]);
+        }
+
+        namespace detail
+        {
+                /* 4x4 矩阵的伴随矩阵，行列式写入 det；不检查可逆性，T 可以是数据包 */
+                template<typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR mat<4, T, Q> adjugate(mat<4, T, Q> const& m, T& det)
+                {
+                        /* 第 r、s 行与第 2-3、1-3、1-2 列组成的 2x2 子式，4 个一组（第一个重复） */
+                        auto fac = [&m] (int r, int s, T (&f)[4]) {
+                                f[0] = f[1] = m[2][r] * m[3][s] - m[3][r] * m[2][s];
+                                f[2] = m[1][r] * m[3][s] - m[3][r] * m[1][s];
+                                f[3] = m[1][r] * m[2][s] - m[2][r] * m[1][s];
+                        };
+
+                        T f0[4], f1[4], f2[4], f3[4], f4[4], f5[4];
+
+                        fac(2, 3, f0); fac(1, 3, f1); fac(1, 2, f2);
+                        fac(0, 3, f3); fac(0, 2, f4); fac(0, 1, f5);
+
+                        mat<4, T, Q> Result;
+
+                        for (int k = 0; k < 4; k++) {
+                                int c = k == 0 ? 1 : 0;
+                                T s = k & 1 ? T(-1) : T(1);
+
+                                T v0 = m[c][0], v1 = m[c][1], v2 = m[c][2], v3 = m[c][3];
+
+                                Result[0][k] = (v1 * f0[k] - v2 * f1[k] + v3 * f2[k]) * s;
+                                Result[1][k] = (v2 * f3[k] - v0 * f0[k] - v3 * f4[k]) * s;
+                                Result[2][k] = (v0 * f1[k] - v1 * f3[k] + v3 * f5[k]) * s;
+                                Result[3][k] = (v1 * f4[k] - v0 * f2[k] - v2 * f5[k]) * s;
+                        }
+
+                        det = m[0][0] * Result[0][0] + m[0][1] * Result[1][0] + m[0][2] * Result[2][0] + m[0][3] * Result[3][0];
+
+                        return Result;
+                }
+
+#if defined(__SSE__)
+                /* 第 R、S 行的一组 2x2 子式，通道排列同 adjugate() 中的 fac：
+                   (m2[R], m2[R], m1[R], m1[R]) * (m3[S], m3[S], m3[S], m2[S]) - (m3[R], m3[R], m3[R], m2[R]) * (m2[S], m2[S], m1[S], m1[S]) */
+                template<int R, int S>
+                VRT_FUNC_DECL VRT_INLINE __m128 inverse_fac(__m128 c1, __m128 c2, __m128 c3)
+                {
+                        __m128 a = _mm_shuffle_ps(c2, c1, _MM_SHUFFLE(R, R, R, R));
+                        __m128 b = _mm_shuffle_ps(c3, c2, _MM_SHUFFLE(S, S, S, S));
+                        __m128 c = _mm_shuffle_ps(c3, c2, _MM_SHUFFLE(R, R, R, R));
+                        __m128 d = _mm_shuffle_ps(c2, c1, _MM_SHUFFLE(S, S, S, S));
+
+                        return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 0, 0, 0))),
+                                          _mm_mul_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 0, 0, 0)), d));
+                }
+
+                /* float 4x4 矩阵的逆矩阵，与 adjugate() 的分组相同：每组 2x2 子式以 shuffle 排成一个寄存器，
+                   伴随矩阵的每一列为 3 次乘加；不可逆时抛出异常 */
+                template<qualifier Q>
+                VRT_FUNC_DECL VRT_INLINE mat<4, float, Q> inverse_sse(mat<4, float, Q> const& m)
+                {
+                        __m128 c0 = _mm_loadu_ps(m[0].data);
+                        __m128 c1 = _mm_loadu_ps(m[1].data);
+                        __m128 c2 = _mm_loadu_ps(m[2].data);
+                        __m128 c3 = _mm_loadu_ps(m[3].data);
+
+                        __m128 f0 = inverse_fac<2, 3>(c1, c2, c3);
+                        __m128 f1 = inverse_fac<1, 3>(c1, c2, c3);
+                        __m128 f2 = inverse_fac<1, 2>(c1, c2, c3);
+                        __m128 f3 = inverse_fac<0, 3>(c1, c2, c3);
+                        __m128 f4 = inverse_fac<0, 2>(c1, c2, c3);
+                        __m128 f5 = inverse_fac<0, 1>(c1, c2, c3);
+
+                        /* vj = (m1[j], m0[j], m0[j], m0[j]) */
+                        __m128 t0 = _mm_shuffle_ps(c1, c0, _MM_SHUFFLE(0, 0, 0, 0));
+                        __m128 t1 = _mm_shuffle_ps(c1, c0, _MM_SHUFFLE(1, 1, 1, 1));
+                        __m128 t2 = _mm_shuffle_ps(c1, c0, _MM_SHUFFLE(2, 2, 2, 2));
+                        __m128 t3 = _mm_shuffle_ps(c1, c0, _MM_SHUFFLE(3, 3, 3, 3));
+
+                        __m128 v0 = _mm_shuffle_ps(t0, t0, _MM_SHUFFLE(2, 2, 2, 0));
+                        __m128 v1 = _mm_shuffle_ps(t1, t1, _MM_SHUFFLE(2, 2, 2, 0));
+                        __m128 v2 = _mm_shuffle_ps(t2, t2, _MM_SHUFFLE(2, 2, 2, 0));
+                        __m128 v3 = _mm_shuffle_ps(t3, t3, _MM_SHUFFLE(2, 2, 2, 0));
+
+                        /* 奇数通道取反：与符号位异或 */
+                        __m128 sign = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+
+                        __m128 r0 = _mm_xor_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(v1, f0), _mm_mul_ps(v2, f1)), _mm_mul_ps(v3, f2)), sign);
+                        __m128 r1 = _mm_xor_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(v2, f3), _mm_mul_ps(v0, f0)), _mm_mul_ps(v3, f4)), sign);
+                        __m128 r2 = _mm_xor_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(v0, f1), _mm_mul_ps(v1, f3)), _mm_mul_ps(v3, f5)), sign);
+                        __m128 r3 = _mm_xor_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(v1, f4), _mm_mul_ps(v0, f2)), _mm_mul_ps(v2, f5)), sign);
+
+                        /* 行列式 = 第一列与伴随矩阵第一行的点积，两次 shuffle 相加后广播到所有通道 */
+                        __m128 row = _mm_shuffle_ps(_mm_unpacklo_ps(r0, r1), _mm_unpacklo_ps(r2, r3), _MM_SHUFFLE(1, 0, 1, 0));
+                        __m128 det = _mm_mul_ps(c0, row);
+
+                        det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 0, 3, 2)));
+                        det = _mm_add_ps(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 3, 0, 1)));
+
+                        if (_mm_cvtss_f32(det) == 0.0f)
+                                throw std::runtime_error("singular matrix");
+
+                        __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+                        mat<4, float, Q> Result;
+                        _mm_storeu_ps(Result[0].data, _mm_mul_ps(r0, inv));
+                        _mm_storeu_ps(Result[1].data, _mm_mul_ps(r1, inv));
+                        _mm_storeu_ps(Result[2].data, _mm_mul_ps(r2, inv));
+                        _mm_storeu_ps(Result[3].data, _mm_mul_ps(r3, inv));
+
+                        return Result;
+                }
+#endif
+
+                /* 以 c0、c1、c2 为列的 3x3 矩阵的逆矩阵的行 = 另外两列的叉积 / 行列式；不可逆时抛出异常 */
+                template<typename T, qualifier Q>
+                VRT_FUNC_DECL VRT_FUNC_CONSTEXPR void inverse_rows(vec<3, T, Q> const& c0, vec<3, T, Q> const& c1, vec<3, T, Q> const& c2, vec<3, T, Q> (&r)[3])
+                {
+                        r[0] = cross(c1, c2);
+                        r[1] = cross(c2, c0);
+                        r[2] = cross(c0, c1);
+
+                        T det = dot(c0, r[0]);
+
+                        if (det == T(0))
+                                throw std::runtime_error("singular matrix");
+
+                        T inv = T(1) / det;
+
+                        r[0] *= inv;
+                        r[1] *= inv;
+                        r[2] *= inv;
+                }
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> inverse(mat<4, T, Q> const& m)
+        {
+#if defined(__SSE__)
+                if constexpr (std::is_same_v<T, float>) {
+                        if !consteval {
+                                return detail::inverse_sse(m);
+                        }
+                }
+#endif
+                T det;
+                mat<4, T, Q> Result = detail::adjugate(m, det);
+
+                if (det == T(0))
+                        throw std::runtime_error("singular matrix");
+
+                T inv = T(1) / det;
+
+                for (int i = 0; i < 4; i++)
+                        Result[i] *= inv;
+
+                return Result;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> affine_inverse(mat<4, T, Q> const& m)
+        {
+                vec<3, T, Q> c0(m[0].x, m[0].y, m[0].z);
+                vec<3, T, Q> c1(m[1].x, m[1].y, m[1].z);
+                vec<3, T, Q> c2(m[2].x, m[2].y, m[2].z);
+                vec<3, T, Q> t(m[3].x, m[3].y, m[3].z);
+
+                vec<3, T, Q> r[3];
+                detail::inverse_rows(c0, c1, c2, r);
+
+                return mat<4, T, Q> {
+                    r[0].x, r[1].x, r[2].x, 0,
+                    r[0].y, r[1].y, r[2].y, 0,
+                    r[0].z, r[1].z, r[2].z, 0,
+                    -dot(r[0], t), -dot(r[1], t), -dot(r[2], t), 1
                 };
-                
-                return m * r;
         }
 
-        template<typename T>
-        VRT_FUNC_CONSTEXPR mat<4, T> scale(mat<4, T> const& m, vec<3, T> const& v)
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> rigid_inverse(mat<4, T, Q> const& m)
+        {
+                vec<3, T, Q> c0(m[0].x, m[0].y, m[0].z);
+                vec<3, T, Q> c1(m[1].x, m[1].y, m[1].z);
+                vec<3, T, Q> c2(m[2].x, m[2].y, m[2].z);
+                vec<3, T, Q> t(m[3].x, m[3].y, m[3].z);
+
+                return mat<4, T, Q> {
+                    c0.x, c1.x, c2.x, 0,
+                    c0.y, c1.y, c2.y, 0,
+                    c0.z, c1.z, c2.z, 0,
+                    -dot(c0, t), -dot(c1, t), -dot(c2, t), 1
+                };
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<2, T, Q> transpose(mat<2, T, Q> const& m)
+        {
+                return mat<2, T, Q>(m[0].x, m[1].x,
+                                    m[0].y, m[1].y);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<3, T, Q> transpose(mat<3, T, Q> const& m)
+        {
+                return mat<3, T, Q>(m[0].x, m[1].x, m[2].x,
+                                    m[0].y, m[1].y, m[2].y,
+                                    m[0].z, m[1].z, m[2].z);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<4, T, Q> transpose(mat<4, T, Q> const& m)
+        {
+#if defined(__SSE__)
+                if constexpr (std::is_same_v<T, float>) {
+                        if !consteval {
+                                __m128 c0 = _mm_loadu_ps(m[0].data);
+                                __m128 c1 = _mm_loadu_ps(m[1].data);
+                                __m128 c2 = _mm_loadu_ps(m[2].data);
+                                __m128 c3 = _mm_loadu_ps(m[3].data);
+
+                                _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+                                mat<4, T, Q> Result;
+                                _mm_storeu_ps(Result[0].data, c0);
+                                _mm_storeu_ps(Result[1].data, c1);
+                                _mm_storeu_ps(Result[2].data, c2);
+                                _mm_storeu_ps(Result[3].data, c3);
+
+                                return Result;
+                        }
+                }
+#endif
+                return mat<4, T, Q>(m[0].x, m[1].x, m[2].x, m[3].x,
+                                    m[0].y, m[1].y, m[2].y, m[3].y,
+                                    m[0].z, m[1].z, m[2].z, m[3].z,
+                                    m[0].w, m[1].w, m[2].w, m[3].w);
+        }
+
+        template<size_t C, size_t R, typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR matrix<R, C, T, Q> transpose(matrix<C, R, T, Q> const& m)
+        {
+                matrix<R, C, T, Q> Result;
+
+                for (size_t r = 0; r < R; r++)
+                        Result[r] = detail::make_vec<C, T, Q>([&] (size_t c) { return m[c][r]; });
+
+                return Result;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T determinant(mat<2, T, Q> const& m)
+        {
+                return m[0].x * m[1].y - m[1].x * m[0].y;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T determinant(mat<3, T, Q> const& m)
+        {
+                return triple(m[0], m[1], m[2]);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR T determinant(mat<4, T, Q> const& m)
+        {
+                /* 第 0-1 行（s）与第 2-3 行（c）各自的 2x2 子式 */
+                T s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+                T s1 = m[0][0] * m[2][1] - m[2][0] * m[0][1];
+                T s2 = m[0][0] * m[3][1] - m[3][0] * m[0][1];
+                T s3 = m[1][0] * m[2][1] - m[2][0] * m[1][1];
+                T s4 = m[1][0] * m[3][1] - m[3][0] * m[1][1];
+                T s5 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+                T c0 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+                T c1 = m[0][2] * m[2][3] - m[2][2] * m[0][3];
+                T c2 = m[0][2] * m[3][3] - m[3][2] * m[0][3];
+                T c3 = m[1][2] * m[2][3] - m[2][2] * m[1][3];
+                T c4 = m[1][2] * m[3][3] - m[3][2] * m[1][3];
+                T c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+
+                return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<3, T, Q> normal_matrix(mat<4, T, Q> const& m)
+        {
+                vec<3, T, Q> c0(m[0].x, m[0].y, m[0].z);
+                vec<3, T, Q> c1(m[1].x, m[1].y, m[1].z);
+                vec<3, T, Q> c2(m[2].x, m[2].y, m[2].z);
+
+                /* 逆矩阵的转置：逆矩阵的行作为列 */
+                vec<3, T, Q> r[3];
+                detail::inverse_rows(c0, c1, c2, r);
+
+                return mat<3, T, Q>(r[0], r[1], r[2]);
+        }
+
+        template<typename T, qualifier Q>
+        VRT_FUNC_CONSTEXPR mat<3, T, Q> normal_matrix_uniform(mat<4, T, Q> const& m)
         {
-                mat<4, T> t(1.0f);
+                vec<3, T, Q> c0(m[0].x, m[0].y, m[0].z);
+                vec<3, T, Q> c1(m[1].x, m[1].y, m[1].z);
+                vec<3, T, Q> c2(m[2].x, m[2].y, m[2].z);
 
-                t[0][0] = v[0];
-                t[1][1] = v[1];
-                t[2][2] = v[2];
+                T inv = T(1) / dot(c0, c0);
 
-                return m * t;
+                return mat<3, T, Q>(c0 * inv, c1 * inv, c2 * inv);
         }
         
 }